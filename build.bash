@@ -3,23 +3,57 @@ set -e
 
 # 1) Clean & prepare
 rm -rf build
-mkdir build
+mkdir -p build/common build/headless build/bench build/packer
 
-# 2) Compile the main launcher
-echo "➜ Compiling ArcadeMain.cpp → ArcadeMain.o"
-g++ -c src/ArcadeMain.cpp -o build/ArcadeMain.o \
-    -Isrc
+# 2) Compile the launcher, the headless runner, the benchmarks and the code they share
+compile() {  # compile SRC_GLOB... into DIR
+  local dir=$1; shift
+  for src in "$@"; do
+    obj="$dir/$(basename "${src%.cpp}").o"
+    echo "➜ Compiling $src → $obj"
+    g++ -c "$src" -o "$obj" \
+        -Isrc
+  done
+}
+compile build src/*.cpp
+compile build/common src/common/*.cpp
+compile build/headless src/headless/*.cpp
+compile build/bench src/bench/*.cpp
+compile build/packer src/packer/*.cpp
 
-# 3) Invoke each module’s build and collect .o files
-for module in pongGame snakeGame asteroidsGame conwayGame spaceInvadersGame; do
+# 3) Build each module (src/*Game) into a plugin the hosts load on demand
+for dir in src/*Game; do
+  module=$(basename "$dir")
   echo "=== Building $module ==="
-  (cd src/$module && bash build.bash)
-  cp src/$module/*.o build/
+  (cd "$dir" && bash build.bash)
+  objs=()
+  for src in "$dir"/*.cpp; do objs+=("${src%.cpp}.o"); done
+  echo "➜ Linking $module → build/lib${module%Game}.so"
+  g++ -shared "${objs[@]}" -o "build/lib${module%Game}.so"
 done
 
-# 4) Link everything into one binary
-echo "➜ Linking all .o → ArcadeGames"
-g++ build/*.o -o ArcadeGames \
+# 4) Link the hosts. Every symbol is exported so the plugins use the host's
+#    raylib (whole, for the launcher; the null one for the headless runner
+#    and the benchmarks) and the shared code.
+echo "➜ Linking launcher → ArcadeGames"
+g++ build/*.o build/common/*.o -o ArcadeGames -rdynamic \
+    -Wl,--whole-archive -lraylib -Wl,--no-whole-archive \
+    -lGL -lm -lpthread -ldl -lrt -lX11
+
+echo "➜ Linking headless runner → ArcadeHeadless"
+g++ build/headless/*.o build/common/*.o -o ArcadeHeadless -rdynamic \
+    -lm -lpthread -ldl
+
+echo "➜ Linking benchmarks → ArcadeBench"
+g++ build/bench/*.o build/headless/platform.o build/common/*.o -o ArcadeBench -rdynamic \
+    -lm -lpthread -ldl
+
+echo "➜ Linking asset packer → ArcadePack"
+g++ build/packer/*.o -o ArcadePack \
     -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
 
-echo "Built ./ArcadeGames"
+# 5) Decode the assets once, here, so the games never wait on PNG/MP3 decode
+echo "➜ Packing assets.cfg → build/assets.pak"
+./ArcadePack assets.cfg build/assets.pak
+
+echo "Built ./ArcadeGames, ./ArcadeHeadless, ./ArcadeBench and ./ArcadePack"
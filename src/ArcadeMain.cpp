@@ -1,100 +1,233 @@
 #include <raylib.h>
 #include <vector>
 #include <string>
+#include <cstring>
+#include <cstdio>
+#include <thread>
+#include <chrono>
 
-// Module headers
-#include "pongGame/pong.hpp"
-#include "snakeGame/snake.hpp"
-#include "asteroidsGame/asteroids.hpp"
-#include "conwayGame/conway.hpp"
-#include "spaceInvadersGame/invaders.hpp"
+// Games are plugins listed in the manifest; see registry.hpp
+#include "common/registry.hpp"
+#include "common/profiler.hpp"
+#include "common/jobs.hpp"
+#include "common/assetpack.hpp"
+#include "common/session.hpp"
+#include "common/simthread.hpp"
+#include "common/framepacer.hpp"
+#include "common/alloctracker.hpp"
+
+static const char* GAMES_MANIFEST = "games.cfg";
+static const char* ASSET_PACK = "build/assets.pak";
+static const char* PROFILE_CSV = "profile.csv";
+
+// A key or button edge from the held state the launcher polled itself;
+// raylib's pressed flags miss presses between its two polls a frame
+struct Edge {
+    bool was = false;
+    bool Pressed(bool down) {
+        bool pressed = down && !was;
+        was = down;
+        return pressed;
+    }
+};
 
 // Application states
 enum class AppState {
     Menu,
-    Pong_Init, Pong_Play,
-    Snake_Init, Snake_Play,
-    Asteroids_Init, Asteroids_Play,
-    Conway_Init, Conway_Play,
-    Invaders_Init, Invaders_Play,
+    Game_Init, Game_Play,
     Exit
 };
 
-int main() {
+int main(int argc, char** argv) {
+    // One job system for every game, started before any of them can use it
+    Jobs().Start((int)std::thread::hardware_concurrency() - 1);
+    GameRegistry games;
+    if (!games.Load(GAMES_MANIFEST)) fprintf(stderr, "%s\n", games.Error().c_str());
+    if (!Assets().Open(ASSET_PACK)) fprintf(stderr, "%s; games load data/ files instead\n", Assets().Error().c_str());
+
+    // --record FILE saves each game played as a session tape, with the game's
+    // options, F6 saves it mid-game; --replay FILE plays one back. Both keep
+    // game simulations on the main thread, stepped by the session clock, so a
+    // tape replays exactly.
+    // --latency starts in the low-latency pacing mode, F7 toggles it.
+    // --strict-allocs reports every heap allocation in steady-state play.
+    const char* recordFile = nullptr;
+    const char* replayFile = nullptr;
+    bool lowLatency = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--latency") == 0) lowLatency = true;
+        else if (strcmp(argv[i], "--strict-allocs") == 0) Allocs().SetStrict(true);
+        else if (i + 1 >= argc) break;
+        else if (strcmp(argv[i], "--record") == 0) recordFile = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0) replayFile = argv[++i];
+    }
+    if (recordFile || replayFile) SimThread::SetInline(true);
+
+    // Command line options belong to the games; only the games named load here
+    for (int i = 1; i < argc; i++) {
+        int g = games.FindOption(argv[i]);
+        if (g < 0) continue;
+        const GameModule* module = games.Get(g);
+        if (!module) { fprintf(stderr, "%s: %s\n", argv[i], games.Error().c_str()); continue; }
+        int exitCode = games.Command(g, argc, argv, &i);
+        if (exitCode >= 0) return exitCode;
+    }
+
     // Choose unified resolution (adjust if needed)
     const int screenWidth = 1200;
     const int screenHeight = 800;
+    // latency pacing wants the present itself to wait for the vblank
+    if (lowLatency) SetConfigFlags(FLAG_VSYNC_HINT);
     InitWindow(screenWidth, screenHeight, "ArcadeGames");
-    SetTargetFPS(60);
+    // The launcher owns the frame rate: the monitor's refresh rate, whatever
+    // the game, as every game keeps its own time. Its pacer limits it, and
+    // decides when input is polled; see framepacer.hpp
+    int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+    if (refreshRate <= 0) refreshRate = 60;
+    SetTargetFPS(0);
+    FramePacer pacer;
+    pacer.SetLatency(lowLatency);
+    pacer.SetRate(refreshRate);
 
     AppState state = AppState::Menu;
+    int current = -1;                   // registry index of the game picked
+    const GameModule* game = nullptr;
+    bool inBackground = false;          // window unfocused or minimised
+    bool paused = false;                // game agreed to stop updating meanwhile
+    std::string loadError;              // why the last pick failed, shown on the menu
+
+    // Frame profiler: F3 shows the overlay, F4 saves the kept frames as CSV;
+    // F8 shows heap allocations per frame and per profiler zone
+    FrameProfiler& profiler = Profiler();
+    const int zoneUpdate = profiler.Zone("update");
+    const int zoneDraw = profiler.Zone("draw");
+    const int zoneBegin = profiler.Zone("BeginDrawing");
+    const int zoneEnd = profiler.Zone("EndDrawing");
+    const int zoneOverlay = profiler.Zone("overlay");
+    const int zoneWait = profiler.Zone("wait");
+    std::string exportNote;
+    double exportNoteUntil = 0;
+    auto note = [&](const std::string& text) {
+        exportNote = text;
+        exportNoteUntil = GetTime() + 3.0;
+    };
+    auto saveSession = [&]() {
+        if (Session().GetMode() != GameSession::RECORDING) return;
+        note(Session().Save(recordFile) ? std::string("Saved ") + recordFile : std::string("Could not write ") + recordFile);
+    };
+    auto leaveGame = [&]() {
+        Allocs().SetSteady(false);
+        game->unload();
+        saveSession();
+        Session().End();
+        state = AppState::Menu;
+    };
+
+    if (replayFile) {
+        if (!Session().BeginReplay(replayFile)) loadError = Session().Error();
+        for (int i = 0; i < games.Count() && loadError.empty(); i++)
+            if (games.Name(i) == Session().Game()) { current = i; state = AppState::Game_Init; }
+        if (loadError.empty() && current < 0) loadError = std::string(replayFile) + " is a session of " + Session().Game() + ", which is not installed";
+        // the tape's game options, so it plays as it was recorded
+        if (loadError.empty() && !games.ApplyOptions(current, Session().Options())) {
+            loadError = games.Error();
+            Session().End();
+            state = AppState::Menu;
+        }
+    }
     
     // Build menu buttons
     typedef std::pair<Rectangle, std::string> Button;
     std::vector<Button> menuButtons;
     int btnW = 300, btnH = 50;
     int startY = 150, spacing = 80;
-    const char* names[] = {"Pong", "Snake", "Asteroids", "Conway's Game of Life", "Space Invaders"};
-    for (int i = 0; i < 5; i++) {
+    for (int i = 0; i < games.Count(); i++) {
         menuButtons.push_back({
             {(screenWidth - btnW)/2.0f, (float)startY + i*spacing, (float)btnW, (float)btnH},
-            names[i]
+            games.Name(i)
         });
     }
     // Center-top back button
     Rectangle backBtn = {(screenWidth - 150)/2.0f, 10.0f, 150.0f, 40.0f};
 
+    Edge f3, f4, f6, f7, f8, click;
     while (!WindowShouldClose() && state != AppState::Exit) {
+        // Sleep until the frame is due, then poll: everything below runs on
+        // this input
+        { ProfileScope scope(zoneWait); pacer.PollInput(); }
+        auto held = [](int key) {return IsKeyDown(key) || IsKeyPressed(key);};
+        if (f3.Pressed(held(KEY_F3))) profiler.Toggle();
+        if (f4.Pressed(held(KEY_F4)))
+            note(profiler.ExportCsv(PROFILE_CSV) ? std::string("Saved ") + PROFILE_CSV : std::string("Could not write ") + PROFILE_CSV);
+        if (f6.Pressed(held(KEY_F6))) {
+            if (!recordFile) note("Start with --record FILE to record");
+            else if (state == AppState::Game_Play) saveSession();
+        }
+        if (f7.Pressed(held(KEY_F7))) {
+            pacer.SetLatency(!pacer.Latency());
+            note(pacer.Latency() ? "Latency pacing" : "Default pacing");
+        }
+        if (f8.Pressed(held(KEY_F8))) Allocs().Toggle();
+        bool clicked = click.Pressed(IsMouseButtonDown(MOUSE_LEFT_BUTTON) || IsMouseButtonPressed(MOUSE_LEFT_BUTTON));
+
         // Update logic
         if (state == AppState::Menu) {
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+            if (clicked) {
                 Vector2 mp = GetMousePosition();
                 for (int i = 0; i < menuButtons.size(); i++) {
                     if (CheckCollisionPointRec(mp, menuButtons[i].first)) {
-                        state = static_cast<AppState>(static_cast<int>(AppState::Pong_Init) + i*2);
+                        current = i;
+                        state = AppState::Game_Init;
                     }
                 }
             }
         } else {
-            int idx = static_cast<int>(state) - static_cast<int>(AppState::Pong_Init);
-            int game = idx / 2; // 0..4
-            int phase = idx % 2; // 0=init,1=play
             switch (state) {
-                case AppState::Pong_Init:       if (InitPong()) state = AppState::Pong_Play; else state = AppState::Menu; break;
-                case AppState::Pong_Play:       UpdatePong();    break;
-
-                case AppState::Snake_Init:      if (InitSnake()) state = AppState::Snake_Play; else state = AppState::Menu; break;
-                case AppState::Snake_Play:      UpdateSnake();   break;
-
-                case AppState::Asteroids_Init:  if (InitAsteroids()) state = AppState::Asteroids_Play; else state = AppState::Menu; break;
-                case AppState::Asteroids_Play:  UpdateAsteroids();    break;
-
-                case AppState::Conway_Init:     if (InitConway()) state = AppState::Conway_Play; else state = AppState::Menu; break;
-                case AppState::Conway_Play:     UpdateConway();   break;
-
-                case AppState::Invaders_Init:   if (InitInvaders()) state = AppState::Invaders_Play; else state = AppState::Menu; break;
-                case AppState::Invaders_Play:   UpdateInvaders();  break;
+                case AppState::Game_Init:
+                    // first pick of a game loads its plugin
+                    game = games.Get(current);
+                    if (!game) { loadError = games.Error(); state = AppState::Menu; break; }
+                    loadError.clear();
+                    inBackground = paused = false;
+                    if (Session().GetMode() != GameSession::REPLAY) {
+                        uint64_t seed = (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+                        Session().Begin(game->name, seed, recordFile != nullptr, games.Options(current));
+                    }
+                    if (!game->init()) { Session().End(); state = AppState::Menu; break; }
+                    Allocs().ResetTotals();     // strict reports count from here
+                    state = AppState::Game_Play;
+                    break;
+                case AppState::Game_Play: {
+                    bool background = !IsWindowFocused() || IsWindowMinimized();
+                    if (background != inBackground) {
+                        inBackground = background;
+                        paused = game->suspend && game->suspend(background) && background;
+                    }
+                    if (paused) break;
+                    // a replay that has run out goes back to the menu
+                    if (!Session().NextTick()) {
+                        loadError = Session().Error();
+                        leaveGame();
+                        break;
+                    }
+                    { ProfileScope scope(zoneUpdate); game->update(); }
+                    Allocs().SetSteady(true);
+                    break;
+                }
                 default: break;
             }
             // Back to menu button click when playing
-            if (phase == 1 && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+            if (state == AppState::Game_Play && clicked) {
                 Vector2 mp = GetMousePosition();
                 if (CheckCollisionPointRec(mp, backBtn)) {
                     // Unload current game and return to menu immediately
-                    switch (game) {
-                        case 0: UnloadPong(); break;
-                        case 1: UnloadSnake(); break;
-                        case 2: UnloadAsteroids(); break;
-                        case 3: UnloadConway(); break;
-                        case 4: UnloadInvaders(); break;
-                    }
-                    state = AppState::Menu;
+                    leaveGame();
                 }
             }
         }
 
         // Draw
-        BeginDrawing();
+        { ProfileScope scope(zoneBegin); BeginDrawing(); }
         ClearBackground(RAYWHITE);
         if (state == AppState::Menu) {
             DrawText("ArcadeGames", (screenWidth - MeasureText("ArcadeGames", 40))/2, 50, 40, DARKBLUE);
@@ -102,22 +235,38 @@ int main() {
                 DrawRectangleRec(b.first, LIGHTGRAY);
                 DrawText(b.second.c_str(), b.first.x + 20, b.first.y + 10, 24, BLACK);
             }
+            if (!loadError.empty())
+                DrawText(loadError.c_str(), 20, screenHeight - 40, 20, RED);
         } else {
-            switch (state) {
-                case AppState::Pong_Play:        DrawPong();        break;
-                case AppState::Snake_Play:       DrawSnake();       break;
-                case AppState::Asteroids_Play:   DrawAsteroids();   break;
-                case AppState::Conway_Play:      DrawConway();      break;
-                case AppState::Invaders_Play:    DrawInvaders();    break;
-                default: break;
-            }
+            if (state == AppState::Game_Play) { ProfileScope scope(zoneDraw); game->draw(); }
             // Draw back button at center-top
             DrawRectangleRec(backBtn, RED);
             DrawText("Main Menu", backBtn.x + 15, backBtn.y + 8, 20, WHITE);
+            if (Session().GetMode() == GameSession::REPLAY)
+                DrawText(TextFormat("REPLAY %lld / %lld", Session().Tick(), Session().Ticks()), 20, screenHeight - 30, 20, MAROON);
+        }
+        {
+            ProfileScope scope(zoneOverlay);
+            if (profiler.Visible()) {
+                profiler.Draw(screenWidth - FrameProfiler::HISTORY - 30, 60);
+                int jobsY = screenHeight - 30 - 30 - 12 * Jobs().Size();
+                Jobs().Draw(screenWidth - FrameProfiler::HISTORY - 30, jobsY);
+                pacer.Draw(screenWidth - FrameProfiler::HISTORY - 30, jobsY - FramePacer::PANEL_H - 10);
+            }
+            if (Allocs().Visible()) Allocs().Draw(20, 60);
+            if (GetTime() < exportNoteUntil) DrawText(exportNote.c_str(), screenWidth - 220, screenHeight - 30, 20, DARKGRAY);
         }
-        EndDrawing();
+        pacer.Submit();
+        { ProfileScope scope(zoneEnd); EndDrawing(); }
+        pacer.Presented();
+        // EndDrawing() polled too; keep what it saw for the next tick
+        Session().Latch();
+        profiler.EndFrame();
+        Allocs().EndFrame();
     }
 
+    if (state == AppState::Game_Play) saveSession();
     CloseWindow();
+    Jobs().Stop();
     return 0;
 }
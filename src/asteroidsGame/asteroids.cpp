@@ -1,9 +1,18 @@
 #include "asteroids.hpp"
-#include <vector>
+#include "spatialgrid.hpp"
+#include "bodyfield.hpp"
+#include "particles.hpp"
+#include "../common/jobs.hpp"
+#include "../common/bench.hpp"
+#include "../common/assetpack.hpp"
+#include "../common/session.hpp"
+#include "lanes.hpp"
 #include <fstream>
+#include <chrono>
 #include <algorithm>
 #include <raylib.h>
 #include <raymath.h>
+#include <rlgl.h>
 
 using namespace std;
 
@@ -13,8 +22,30 @@ enum class GameState { START_SCREEN, COUNTDOWN, PLAYING, GAME_OVER };
 enum class AstSize { LARGE = 0, MED = 1, SMALL = 2 };
 
 static const int ASTEROID_COUNT = 15;
+static const int MAX_ASTEROIDS = ASTEROID_COUNT * 4; // a wave split all the way down
+static const int MAX_BULLETS = 64;
+static const int MAX_SPLITS_PER_FRAME = MAX_BULLETS * 2;
+// a few hundred thousand emits a second, each living up to 1 s, before the
+// ring starts overwriting particles that are still alive
+static const int MAX_PARTICLES = 300000;
 static const int INITIAL_LIVES = 3;
 static const char* HIGHSCORE_FILE = "src/asteroidsGame/highscore.txt";
+static const float GRID_CELL_SIZE = 100.0f; // largest asteroid diameter
+static const int STRESS_MIN = 10000;
+static const int STRESS_MAX = 100000;
+static const int STRESS_STEP = 10000;
+static const int STRESS_CLI_MAX = 1000000;
+static const int STRESS_GRAIN = 1024;         // rocks per worker chunk, multiple of 8
+static const float STRESS_COVERAGE = 0.25f;   // share of the screen covered by rocks
+// The field moves in fixed steps at the rate the ship's handling was tuned
+// at, whatever the frame rate, and is drawn between the last two steps
+static const float STEP = 1.0f / 60.0f;
+static const float MAX_FRAME_TIME = 0.25f;
+
+// Broadphase over the wrapped screen, rebuilt every frame
+static SpatialGrid grid;
+// Explosion debris and engine sparks
+static ParticleSystem particles;
 
 // --- Utility ---
 static Vector2 WrapPosition(const Vector2& pos) {
@@ -26,13 +57,15 @@ static Vector2 WrapPosition(const Vector2& pos) {
     return r;
 }
 static bool CheckOverlap(const Vector2& a, float ra, const Vector2& b, float rb) {
-    return Vector2Distance(a, b) < (ra + rb);
+    return grid.Overlap(a, ra, b, rb);
 }
 
 // --- Ship ---
 struct Ship {
     Vector2 pos;
     float rot;
+    Vector2 prevPos;    // before the last step, for drawing between steps
+    float prevRot;
     Vector2 vel;
     ShipState state;
     float explosionTimer;
@@ -44,18 +77,24 @@ struct Ship {
         pos = {(float)GetScreenWidth()/2, (float)GetScreenHeight()/2};
         rot = 0;
         vel = {0,0};
+        prevPos = pos;
+        prevRot = rot;
         state = ShipState::ALIVE;
         explosionTimer = invincibleTimer = 0;
         lives = INITIAL_LIVES;
     }
-    void Update() {
-        float dt = GetFrameTime();
+    // One step; vel is per step, so thrust and drag assume STEP
+    void Update(float dt) {
+        prevPos = pos;
+        prevRot = rot;
         if (state == ShipState::ALIVE || state == ShipState::INVINCIBLE) {
-            if (IsKeyDown(KEY_LEFT)) rot -= 300*dt;
-            if (IsKeyDown(KEY_RIGHT)) rot += 300*dt;
-            if (IsKeyDown(KEY_UP)) {
+            if (Session().KeyDown(KEY_LEFT)) rot -= 300*dt;
+            if (Session().KeyDown(KEY_RIGHT)) rot += 300*dt;
+            if (Session().KeyDown(KEY_UP)) {
                 Vector2 fwd = Vector2Rotate({0,-1}, rot*DEG2RAD);
                 vel = Vector2Add(vel, Vector2Scale(fwd, 30*dt));
+                Vector2 tail = Vector2Add(pos, Vector2Rotate({0,4}, rot*DEG2RAD));
+                particles.Spray(tail, Vector2Scale(fwd, -1), 0.35f, 4, 180, 0.35f, ORANGE);
             }
             vel = Vector2Scale(vel, 0.99f);
             pos = WrapPosition(Vector2Add(pos, vel));
@@ -67,25 +106,27 @@ struct Ship {
             explosionTimer -= dt;
             if (explosionTimer <= 0) {
                 state = ShipState::INVINCIBLE;
-                pos = {(float)GetScreenWidth()/2, (float)GetScreenHeight()/2};
+                pos = prevPos = {(float)GetScreenWidth()/2, (float)GetScreenHeight()/2};
                 vel = {0,0};
                 invincibleTimer = 2.0f;
             }
         }
     }
-    void Draw() const {
-        if (state == ShipState::EXPLODED) {
-            DrawCircleV(pos, 30*explosionTimer, ORANGE);
-            return;
-        }
+    // alpha: how far the frame is from the last step to the next
+    void Draw(float alpha) const {
+        if (state == ShipState::EXPLODED) return; // debris is in the particle system
         bool drawShip = true;
         if (state == ShipState::INVINCIBLE) drawShip = ((int)(invincibleTimer*10) % 2) == 0;
         if (!drawShip) return;
+        // no sliding back across the screen after a wrap
+        bool wrapped = fabsf(pos.x - prevPos.x) > GetScreenWidth()/2 || fabsf(pos.y - prevPos.y) > GetScreenHeight()/2;
+        Vector2 at = wrapped ? pos : Vector2Lerp(prevPos, pos, alpha);
+        float angle = (prevRot + (rot - prevRot)*alpha)*DEG2RAD;
         Vector2 pts[4] = {
-            Vector2Add(pos, Vector2Rotate({0,-16}, rot*DEG2RAD)),
-            Vector2Add(pos, Vector2Rotate({-12,8}, rot*DEG2RAD)),
-            Vector2Add(pos, Vector2Rotate({0,2}, rot*DEG2RAD)),
-            Vector2Add(pos, Vector2Rotate({12,8}, rot*DEG2RAD))
+            Vector2Add(at, Vector2Rotate({0,-16}, angle)),
+            Vector2Add(at, Vector2Rotate({-12,8}, angle)),
+            Vector2Add(at, Vector2Rotate({0,2}, angle)),
+            Vector2Add(at, Vector2Rotate({12,8}, angle))
         };
         for (int i = 0; i < 4; ++i) DrawLineV(pts[i], pts[(i+1)%4], WHITE);
     }
@@ -94,62 +135,36 @@ struct Ship {
             state = ShipState::EXPLODED;
             explosionTimer = 1.0f;
             lives--;
+            particles.Burst(pos, 150, 40, 260, 1.0f, ORANGE);
+            particles.Burst(pos, 60, 20, 120, 1.0f, WHITE);
         }
     }
 };
 
-// --- Asteroid ---
-struct Asteroid {
-    Vector2 pos;
-    Vector2 vel;
-    AstSize size;
-    bool active;
-
-    Asteroid(AstSize s, const Vector2& spawn, const Ship& ship): size(s), active(true) {
-        // avoid spawning on top of ship
-        do {
-            pos = spawn.x < 0 ? Vector2{(float)GetRandomValue(0,GetScreenWidth()), (float)GetRandomValue(0,GetScreenHeight())} : spawn;
-        } while (CheckOverlap(pos, Radius(), ship.pos, 20));
-        float ang = GetRandomValue(0,360)*DEG2RAD;
-        float speed = (float)GetRandomValue(20,70);
-        vel = {cosf(ang)*speed, sinf(ang)*speed};
-    }
-    Asteroid(AstSize s, const Ship& ship): Asteroid(s, { -1,-1 }, ship) {}
-
-    float Radius() const { return size == AstSize::LARGE ? 50 : size == AstSize::MED ? 30 : 15; }
-    void Update() { if (active) pos = WrapPosition(Vector2Add(pos, Vector2Scale(vel, GetFrameTime()))); }
-    void Draw() const { if (active) DrawCircleV(pos, Radius(), GRAY); }
-};
-
-// --- Bullet ---
-struct Bullet {
-    Vector2 pos;
-    Vector2 vel;
-    float life;
-    bool active;
-    Bullet(const Vector2& p, float rot) : pos(p), life(2.0f), active(true) {
-        Vector2 dir = Vector2Rotate({0,-1}, rot*DEG2RAD);
-        vel = Vector2Scale(dir, 400);
-    }
-    void Update() {
-        pos = WrapPosition(Vector2Add(pos, Vector2Scale(vel, GetFrameTime())));
-        life -= GetFrameTime();
-        if (life <= 0) active = false;
-    }
-    void Draw() const { if (active) DrawCircleV(pos, 2, RED); }
-};
-
 // --- Globals ---
 static Ship ship;
-static vector<Asteroid> asteroids;
-static vector<Bullet> bullets;
+static BodyField asteroids;  // rocks; tier holds the AstSize
+static BodyField bullets;
 static int score = 0;
 static int highScore = 0;
 static bool gameOverSoundPlayed = false;
 static double countdownStart = 0;
+static float accumulator = 0;         // frame time not yet stepped
 static Sound shootSfx, explodeSfx, gameOverSfx;
 static GameState gameState;
 
+// --- Stress mode state ---
+static bool stressMode = false;
+static int stressCount = STRESS_MIN;
+static int spawnedCount = -1;         // rocks the field was set up for; 0 = normal game
+static float stressRadius = 0;
+static float* bounceVx = nullptr;     // velocities after rock-rock bounces
+static float* bounceVy = nullptr;
+static vector<long long> workerTests; // padded per worker to avoid false sharing
+static long long pairTests = 0;
+static double updateMs = 0;
+static double drawMs = 0;
+
 // --- Highscore I/O ---
 static void LoadHighScore() {
     ifstream f(HIGHSCORE_FILE);
@@ -160,49 +175,170 @@ static void SaveHighScore() {
     f << highScore;
 }
 
+// --- Asteroid & Bullet ---
+static float AsteroidRadius(AstSize size) { return size == AstSize::LARGE ? 50 : size == AstSize::MED ? 30 : 15; }
+
+static Vector2 RandomDrift() {
+    float ang = Session().Random(0,360)*DEG2RAD;
+    float speed = (float)Session().Random(20,70);
+    return {cosf(ang)*speed, sinf(ang)*speed};
+}
+
+// new rock at a random spot clear of the ship
+static void AddAsteroid(AstSize size) {
+    float r = AsteroidRadius(size);
+    Vector2 pos;
+    do {
+        pos = {(float)Session().Random(0,GetScreenWidth()), (float)Session().Random(0,GetScreenHeight())};
+    } while (CheckOverlap(pos, r, ship.pos, 20));
+    Vector2 vel = RandomDrift();
+    asteroids.Add(pos.x, pos.y, vel.x, vel.y, r, 0, (uint8_t)size);
+}
+
+// split fragment; queued so the collision pass never grows the field
+static void SpawnFragment(AstSize size, const Vector2& pos) {
+    Vector2 vel = RandomDrift();
+    asteroids.Spawn(pos.x, pos.y, vel.x, vel.y, AsteroidRadius(size), 0, (uint8_t)size);
+}
+
+static void AddBullet(const Vector2& pos, float rot) {
+    Vector2 vel = Vector2Scale(Vector2Rotate({0,-1}, rot*DEG2RAD), 400);
+    bullets.Add(pos.x, pos.y, vel.x, vel.y, 2, 2.0f, 0);
+}
+
 // --- Spawn & Cleanup ---
 static void SpawnAsteroids() {
-    asteroids.clear();
+    asteroids.Clear();
+    if (stressMode) {
+        // tiny rocks sized so the whole field covers a fixed share of the screen
+        for (int i = 0; i < stressCount; ++i) {
+            float r = stressRadius * Session().Random(50, 150) / 100.0f;
+            Vector2 pos = {(float)Session().Random(0,GetScreenWidth()), (float)Session().Random(0,GetScreenHeight())};
+            Vector2 vel = RandomDrift();
+            asteroids.Add(pos.x, pos.y, vel.x, vel.y, r, 0, (uint8_t)AstSize::SMALL);
+        }
+        return;
+    }
     for (int i = 0; i < ASTEROID_COUNT; ++i)
-        asteroids.emplace_back(AstSize::LARGE, ship);
+        AddAsteroid(AstSize::LARGE);
 }
 
-// cleanup bullets
-static void Cleanup(vector<Bullet>& v) {
-    v.erase(remove_if(v.begin(), v.end(), [](auto& b){ return !b.active; }), v.end());
+// size the field, grid and workers for the current mode; allocates
+static void SetupField() {
+    float w = (float)GetScreenWidth(), h = (float)GetScreenHeight();
+    free(bounceVx); free(bounceVy);
+    bounceVx = bounceVy = nullptr;
+    if (stressMode) {
+        stressRadius = Clamp(sqrtf(w * h * STRESS_COVERAGE / (stressCount * PI)), 1.5f, 15.0f);
+        grid.Resize(w, h, 3 * stressRadius); // largest stress rock diameter
+        asteroids.Init(stressCount, MAX_SPLITS_PER_FRAME);
+        bounceVx = AllocLanes<float>(asteroids.Capacity());
+        bounceVy = AllocLanes<float>(asteroids.Capacity());
+        workerTests.assign(Jobs().Size() * 8, 0);
+        spawnedCount = stressCount;
+    } else {
+        grid.Resize(w, h, GRID_CELL_SIZE);
+        asteroids.Init(MAX_ASTEROIDS, MAX_SPLITS_PER_FRAME);
+        spawnedCount = 0;
+    }
+    grid.Reserve(asteroids.Capacity());
 }
-// cleanup asteroids and respawn if none left
-static void Cleanup(vector<Asteroid>& v) {
-    v.erase(remove_if(v.begin(), v.end(), [](auto& a){ return !a.active; }), v.end());
-    if (v.empty()) SpawnAsteroids();
+
+// recycle dead slots, apply queued splits, respawn if no rocks are left
+static void Cleanup() {
+    bullets.Reclaim();
+    asteroids.Reclaim();
+    asteroids.FlushSpawns();
+    if (asteroids.Live() == 0) SpawnAsteroids();
 }
 
 // --- Collisions ---
+// Stress mode only: equal-mass elastic bounces between rocks. Each worker
+// writes just its own rocks' new velocities, reading the old ones, so the
+// result does not depend on how the chunks were scheduled.
+static void BounceRocks() {
+    const float* x = asteroids.x;
+    const float* y = asteroids.y;
+    const float* vx = asteroids.vx;
+    const float* vy = asteroids.vy;
+    const float* radius = asteroids.radius;
+    const uint8_t* active = asteroids.active;
+    fill(workerTests.begin(), workerTests.end(), 0);
+
+    auto bounce = [&](int begin, int end, int worker) {
+        long long tests = 0;
+        for (int i = begin; i < end; ++i) {
+            bounceVx[i] = vx[i];
+            bounceVy[i] = vy[i];
+            if (!active[i]) continue;
+            Vector2 pi = {x[i], y[i]};
+            float ri = radius[i];
+            grid.Query(pi, ri, [&](int j) {
+                if (j == i) return false;
+                tests++;
+                Vector2 d = grid.Delta(pi, {x[j], y[j]});
+                float dist2 = d.x*d.x + d.y*d.y;
+                float rr = ri + radius[j];
+                if (dist2 >= rr*rr || dist2 == 0) return false;
+                float approach = (vx[j] - vx[i])*d.x + (vy[j] - vy[i])*d.y;
+                if (approach < 0) {
+                    float k = approach / dist2;
+                    bounceVx[i] += k * d.x;
+                    bounceVy[i] += k * d.y;
+                }
+                return false;
+            });
+        }
+        workerTests[worker * 8] += tests;
+    };
+    int n = asteroids.Span();
+    Jobs().ParallelFor(n, STRESS_GRAIN, bounce);
+    memcpy(asteroids.vx, bounceVx, n * sizeof(float));
+    memcpy(asteroids.vy, bounceVy, n * sizeof(float));
+    pairTests = 0;
+    for (int w = 0; w < Jobs().Size(); ++w) pairTests += workerTests[w * 8];
+}
+
 static void HandleCollisions() {
-    // ship-asteroid
-    if ((ship.state == ShipState::ALIVE) || (ship.state == ShipState::INVINCIBLE)) {
-        for (auto& a : asteroids) {
-            if (a.active && CheckOverlap(ship.pos, 12, a.pos, a.Radius())) {
-                ship.Explode();
-                PlaySound(explodeSfx);
-                if (ship.lives <= 0) gameState = GameState::GAME_OVER;
-                break;
-            }
+    // broadphase: bin live asteroids by centre
+    grid.Clear();
+    for (int i = 0; i < asteroids.Span(); ++i)
+        if (asteroids.active[i]) grid.Add(i, {asteroids.x[i], asteroids.y[i]}, asteroids.radius[i]);
+    grid.Build();
+
+    if (stressMode) BounceRocks();
+
+    // ship-asteroid; the stress field is just scenery for the ship
+    if (!stressMode && ((ship.state == ShipState::ALIVE) || (ship.state == ShipState::INVINCIBLE))) {
+        bool hit = false;
+        grid.Query(ship.pos, 12, [&](int i) {
+            hit = CheckOverlap(ship.pos, 12, {asteroids.x[i], asteroids.y[i]}, asteroids.radius[i]);
+            return hit;
+        });
+        if (hit) {
+            ship.Explode();
+            PlaySound(explodeSfx);
+            if (ship.lives <= 0) gameState = GameState::GAME_OVER;
         }
     }
     // bullet-asteroid
-    for (auto& b : bullets) if (b.active) {
-        for (auto& a : asteroids) if (a.active) {
-            if (CheckOverlap(b.pos, 2, a.pos, a.Radius())) {
-                b.active = a.active = false;
-                score += (3 - (int)a.size) * 10;
-                if (a.size != AstSize::SMALL) {
-                    Vector2 base = a.pos;
-                    asteroids.emplace_back((AstSize)((int)a.size + 1), base + Vector2{10,10}, ship);
-                    asteroids.emplace_back((AstSize)((int)a.size + 1), base - Vector2{10,10}, ship);
-                }
-                break;
-            }
+    for (int b = 0; b < bullets.Span(); ++b) if (bullets.active[b]) {
+        Vector2 bpos = {bullets.x[b], bullets.y[b]};
+        int hitIdx = -1;
+        grid.Query(bpos, 2, [&](int i) {
+            if (asteroids.active[i] && CheckOverlap(bpos, 2, {asteroids.x[i], asteroids.y[i]}, asteroids.radius[i])) hitIdx = i;
+            return hitIdx >= 0;
+        });
+        if (hitIdx < 0) continue;
+
+        AstSize size = (AstSize)asteroids.tier[hitIdx];
+        Vector2 base = {asteroids.x[hitIdx], asteroids.y[hitIdx]};
+        bullets.active[b] = asteroids.active[hitIdx] = 0;
+        score += (3 - (int)size) * 10;
+        particles.Burst(base, (int)asteroids.radius[hitIdx], 30, 220, 0.8f, LIGHTGRAY);
+        if (size != AstSize::SMALL) {
+            SpawnFragment((AstSize)((int)size + 1), base + Vector2{10,10});
+            SpawnFragment((AstSize)((int)size + 1), base - Vector2{10,10});
         }
     }
 }
@@ -210,45 +346,83 @@ static void HandleCollisions() {
 // --- Initialization ---
 bool InitAsteroids() {
     InitAudioDevice();
-    shootSfx    = LoadSound("data/asteroids/SE/shoot.mp3");
-    explodeSfx  = LoadSound("data/asteroids/SE/explode.mp3");
-    gameOverSfx = LoadSound("data/asteroids/SE/gameOver.mp3");
+    shootSfx    = Assets().LoadSound("data/asteroids/SE/shoot.mp3");
+    explodeSfx  = Assets().LoadSound("data/asteroids/SE/explode.mp3");
+    gameOverSfx = Assets().LoadSound("data/asteroids/SE/gameOver.mp3");
     LoadHighScore(); score = 0; gameOverSoundPlayed = false;
-    ship.Reset(); bullets.clear(); SpawnAsteroids();
+    SetupField();
+    bullets.Init(MAX_BULLETS, 0);
+    particles.Init(MAX_PARTICLES);
+    ship.Reset(); bullets.Clear(); SpawnAsteroids();
     gameState = GameState::START_SCREEN;
     return true;
 }
 
+void SetAsteroidsStressCount(int count) {
+    stressMode = count > 0;
+    if (stressMode) stressCount = min(count, STRESS_CLI_MAX);
+}
+
 // --- Update ---
+// One fixed step of play: the ship, then the field, then what hit what
+static void StepField() {
+    ship.Update(STEP);
+    // the particles touch nothing else, so they move alongside the rocks
+    float w = (float)GetScreenWidth(), h = (float)GetScreenHeight();
+    JobCounter sparks;
+    auto drift = [&](int) { particles.Update(STEP, 1.5f); };
+    Jobs().Run(drift, sparks);
+    auto integrate = [&](int begin, int end, int) { asteroids.Integrate(STEP, w, h, begin, end); };
+    Jobs().ParallelFor(asteroids.Span(), STRESS_GRAIN, integrate);
+    bullets.Integrate(STEP, w, h);
+    bullets.Age(STEP);
+    Jobs().Wait(sparks);
+    HandleCollisions();
+    Cleanup();
+}
+
 void UpdateAsteroids() {
-    if (IsKeyPressed(KEY_BACKSPACE)) gameState = GameState::START_SCREEN;
+    if (Session().KeyPressed(KEY_BACKSPACE)) gameState = GameState::START_SCREEN;
     switch (gameState) {
         case GameState::START_SCREEN:
-            if (IsKeyPressed(KEY_ENTER)) { gameState = GameState::COUNTDOWN; countdownStart = GetTime(); }
+            if (Session().KeyPressed(KEY_S)) stressMode = !stressMode;
+            if (stressMode && Session().KeyPressed(KEY_UP)) stressCount = min(STRESS_MAX, (stressCount / STRESS_STEP + 1) * STRESS_STEP);
+            if (stressMode && Session().KeyPressed(KEY_DOWN)) stressCount = max(STRESS_MIN, (stressCount - 1) / STRESS_STEP * STRESS_STEP);
+            if (Session().KeyPressed(KEY_ENTER)) {
+                // a changed mode or count starts a fresh field
+                if (spawnedCount != (stressMode ? stressCount : 0)) {
+                    SetupField();
+                    ship.Reset(); bullets.Clear(); particles.Clear(); SpawnAsteroids(); score = 0;
+                }
+                gameState = GameState::COUNTDOWN; countdownStart = Session().Time();
+            }
             break;
         case GameState::COUNTDOWN: {
-            double elapsed = GetTime() - countdownStart;
-            if (elapsed >= 3.0) gameState = GameState::PLAYING;
+            double elapsed = Session().Time() - countdownStart;
+            if (elapsed >= 3.0) { gameState = GameState::PLAYING; accumulator = 0; }
             break;
         }
-        case GameState::PLAYING:
-            if (IsKeyPressed(KEY_SPACE) && (ship.state == ShipState::ALIVE || ship.state == ShipState::INVINCIBLE)) {
-                bullets.emplace_back(ship.pos, ship.rot);
+        case GameState::PLAYING: {
+            if (Session().KeyPressed(KEY_SPACE) && (ship.state == ShipState::ALIVE || ship.state == ShipState::INVINCIBLE)) {
+                AddBullet(ship.pos, ship.rot);
                 PlaySound(shootSfx);
             }
-            ship.Update();
-            for (auto& a : asteroids) a.Update();
-            for (auto& b : bullets) b.Update();
-            HandleCollisions();
-            Cleanup(bullets); Cleanup(asteroids);
+            auto start = chrono::steady_clock::now();
+            accumulator += fminf(Session().FrameTime(), MAX_FRAME_TIME);
+            while (accumulator >= STEP && gameState == GameState::PLAYING) {
+                accumulator -= STEP;
+                StepField();
+            }
+            updateMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
             if (gameState == GameState::GAME_OVER && !gameOverSoundPlayed) {
                 PlaySound(gameOverSfx); gameOverSoundPlayed = true;
                 if (score > highScore) { highScore = score; SaveHighScore(); }
             }
             break;
+        }
         case GameState::GAME_OVER:
-            if (IsKeyPressed(KEY_R)) {
-                ship.Reset(); bullets.clear(); SpawnAsteroids(); score = 0; gameOverSoundPlayed = false;
+            if (Session().KeyPressed(KEY_R)) {
+                ship.Reset(); bullets.Clear(); particles.Clear(); SpawnAsteroids(); score = 0; gameOverSoundPlayed = false;
                 gameState = GameState::START_SCREEN;
             }
             break;
@@ -256,32 +430,77 @@ void UpdateAsteroids() {
 }
 
 // --- Draw ---
+// Stress rocks as one batch of quads; a tessellated circle each is the first
+// thing to fall over at these counts.
+static void DrawRockBatch(float back) {
+    Color c = GRAY;
+    rlBegin(RL_QUADS);
+    rlColor4ub(c.r, c.g, c.b, c.a);
+    for (int i = 0; i < asteroids.Span(); ++i) {
+        if (!asteroids.active[i]) continue;
+        float x = asteroids.x[i] - asteroids.vx[i]*back, y = asteroids.y[i] - asteroids.vy[i]*back;
+        float r = asteroids.radius[i];
+        rlVertex2f(x - r, y - r);
+        rlVertex2f(x - r, y + r);
+        rlVertex2f(x + r, y + r);
+        rlVertex2f(x + r, y - r);
+    }
+    rlEnd();
+}
+
+static void DrawStressStats() {
+    DrawRectangle(0, GetScreenHeight()-90, 520, 90, Fade(BLACK, 0.7f));
+    DrawText(TextFormat("Rocks: %i   Pair tests: %lld", asteroids.Live(), pairTests), 10, GetScreenHeight()-80, 20, GREEN);
+    DrawText(TextFormat("Update: %.2f ms   Draw: %.2f ms", updateMs, drawMs), 10, GetScreenHeight()-55, 20, GREEN);
+    DrawText(TextFormat("Threads: %i   FPS: %i", Jobs().Size(), GetFPS()), 10, GetScreenHeight()-30, 20, GREEN);
+}
+
 void DrawAsteroids() {
-    BeginDrawing(); ClearBackground(BLACK);
+    ClearBackground(BLACK);
     switch (gameState) {
         case GameState::START_SCREEN:
             DrawText("ASTEROIDS", GetScreenWidth()/2-200, GetScreenHeight()/2-80, 60, WHITE);
             DrawText("Press ENTER to Start", GetScreenWidth()/2-200, GetScreenHeight()/2-20, 40, WHITE);
             DrawText("Backspace to menu", GetScreenWidth()/2-200, GetScreenHeight()/2+40, 20, WHITE);
+            DrawText(TextFormat("S: stress mode [%s]", stressMode ? "ON" : "OFF"), GetScreenWidth()/2-200, GetScreenHeight()/2+80, 20, WHITE);
+            if (stressMode)
+                DrawText(TextFormat("UP/DOWN: rocks %i", stressCount), GetScreenWidth()/2-200, GetScreenHeight()/2+110, 20, WHITE);
             break;
         case GameState::COUNTDOWN: {
-            int count = 3 - (int)(GetTime() - countdownStart);
+            int count = 3 - (int)(Session().Time() - countdownStart);
             if (count < 1) count = 1;
             DrawText(TextFormat("%i", count), GetScreenWidth()/2-20, GetScreenHeight()/2-20, 60, WHITE);
             break;
         }
-        case GameState::PLAYING:
-            ship.Draw(); for (auto& a : asteroids) a.Draw(); for (auto& b : bullets) b.Draw();
+        case GameState::PLAYING: {
+            auto start = chrono::steady_clock::now();
+            // Bodies move in straight lines between steps, so stepping back
+            // along their velocity puts them between the last two steps
+            float back = STEP - accumulator;
+            particles.Draw(back);
+            ship.Draw(accumulator / STEP);
+            if (stressMode) DrawRockBatch(back);
+            else {
+                for (int i = 0; i < asteroids.Span(); ++i)
+                    if (asteroids.active[i])
+                        DrawCircleV({asteroids.x[i] - asteroids.vx[i]*back, asteroids.y[i] - asteroids.vy[i]*back},
+                                    asteroids.radius[i], GRAY);
+            }
+            for (int i = 0; i < bullets.Span(); ++i)
+                if (bullets.active[i])
+                    DrawCircleV({bullets.x[i] - bullets.vx[i]*back, bullets.y[i] - bullets.vy[i]*back}, bullets.radius[i], RED);
+            drawMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            if (stressMode) DrawStressStats();
             DrawText(TextFormat("Score:%04i", score), 10, 10, 20, WHITE);
             DrawText(TextFormat("Lives:%i", ship.lives), 10, 40, 20, WHITE);
             DrawText(TextFormat("High:%04i", highScore), GetScreenWidth()-140, 10, 20, WHITE);
             break;
+        }
         case GameState::GAME_OVER:
             DrawText("GAME OVER", GetScreenWidth()/2-200, GetScreenHeight()/2-40, 60, RED);
             DrawText("Press R to Restart", GetScreenWidth()/2-200, GetScreenHeight()/2+20, 40, WHITE);
             break;
     }
-    EndDrawing();
 }
 
 // --- Unload ---
@@ -291,3 +510,33 @@ void UnloadAsteroids() {
     UnloadSound(gameOverSfx);
     CloseAudioDevice();
 }
+
+// --- Benchmarks ---
+// One HandleCollisions pass: the normal wave, then stress fields of growing
+// size (those run on the shared job system, one worker per core). Nothing moves
+// between runs, so every run tests the same pairs.
+void AddAsteroidsBenchmarks(BenchSuite& suite) {
+    static bool savedStress;
+    static int savedCount;
+    suite.Add({"asteroids/collisions", "rocks", {ASTEROID_COUNT, 1000, 10000, 100000},
+        [](int size, uint64_t seed) {
+            savedStress = stressMode;
+            savedCount = stressCount;
+            stressMode = size > ASTEROID_COUNT;
+            stressCount = size;
+            Session().SeedRandom(seed);
+            SetupField();
+            bullets.Init(MAX_BULLETS, 0);
+            ship.Reset(); SpawnAsteroids();
+            gameState = GameState::PLAYING;
+        },
+        [] {
+            HandleCollisions();
+            BenchSink(asteroids.Live());
+        },
+        [] {
+            stressMode = savedStress;
+            stressCount = savedCount;
+            asteroids.Clear();
+        }});
+}
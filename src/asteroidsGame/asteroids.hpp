@@ -1,7 +1,13 @@
 #pragma once
 #include "raylib.h"
 
+class BenchSuite;
+
 bool InitAsteroids();
 void UpdateAsteroids();
 void DrawAsteroids();
-void UnloadAsteroids();
\ No newline at end of file
+void UnloadAsteroids();
+// Rock count for the stress mode; 0 keeps the normal game as the default.
+void SetAsteroidsStressCount(int count);
+// Adds the collision pass, normal and stress sized, to ArcadeBench.
+void AddAsteroidsBenchmarks(BenchSuite& suite);
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "asteroids.hpp"
+#include "../gamemodule.hpp"
+#include <cstring>
+#include <cstdlib>
+
+static int AsteroidsCommand(int argc, char** argv, int* i) {
+    if (strcmp(argv[*i], "--asteroids-stress") == 0 && *i + 1 < argc)
+        SetAsteroidsStressCount(atoi(argv[++*i]));
+    return -1;
+}
+
+extern "C" const GameModule* ArcadeGetModule() {
+    static const GameModule module = {"Asteroids", InitAsteroids, UpdateAsteroids, DrawAsteroids, UnloadAsteroids, nullptr, AsteroidsCommand, AddAsteroidsBenchmarks};
+    return &module;
+}
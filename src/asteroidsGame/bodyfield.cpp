@@ -0,0 +1,162 @@
+#include "bodyfield.hpp"
+#include "lanes.hpp"
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+BodyField::BodyField()
+: span(0), capacity(0), live(0), freeCount(0), pendingCount(0), spawnCapacity(0), dropped(0),
+  gen(nullptr), freeList(nullptr), pending(nullptr),
+  x(nullptr), y(nullptr), vx(nullptr), vy(nullptr),
+  radius(nullptr), life(nullptr), active(nullptr), tier(nullptr) {}
+
+BodyField::~BodyField() {
+    Release();
+}
+
+void BodyField::Release() {
+    std::free(x); std::free(y); std::free(vx); std::free(vy);
+    std::free(radius); std::free(life); std::free(active); std::free(tier);
+    std::free(gen); std::free(freeList); std::free(pending);
+    x = y = vx = vy = radius = life = nullptr;
+    active = tier = nullptr;
+    gen = nullptr; freeList = nullptr; pending = nullptr;
+    capacity = spawnCapacity = 0;
+}
+
+void BodyField::Init(int maxBodies, int maxPendingSpawns) {
+    Release();
+    capacity = RoundUpLanes(maxBodies);
+    spawnCapacity = maxPendingSpawns;
+    x = AllocLanes<float>(capacity); y = AllocLanes<float>(capacity);
+    vx = AllocLanes<float>(capacity); vy = AllocLanes<float>(capacity);
+    radius = AllocLanes<float>(capacity); life = AllocLanes<float>(capacity);
+    active = AllocLanes<uint8_t>(capacity); tier = AllocLanes<uint8_t>(capacity);
+    gen = AllocLanes<uint32_t>(capacity);
+    freeList = AllocLanes<int>(capacity);
+    pending = AllocLanes<PendingSpawn>(spawnCapacity);
+    Clear();
+}
+
+// Frees every slot. Generations keep counting so old handles stay stale.
+void BodyField::Clear() {
+    for (int i = 0; i < span; i++) {
+        active[i] = 0;
+        if (gen[i] & 1) gen[i]++;
+    }
+    span = live = freeCount = pendingCount = 0;
+}
+
+BodyHandle BodyField::Add(float px, float py, float pvx, float pvy, float r, float lifetime, uint8_t t) {
+    int i;
+    if (freeCount > 0) i = freeList[--freeCount];
+    else if (span < capacity) i = span++;
+    else { dropped++; return {UINT32_MAX, 0}; }
+    x[i] = px; y[i] = py;
+    vx[i] = pvx; vy[i] = pvy;
+    radius[i] = r; life[i] = lifetime;
+    active[i] = 1; tier[i] = t;
+    gen[i]++;
+    live++;
+    return {(uint32_t)i, gen[i]};
+}
+
+// Queues a body to be added by FlushSpawns(); safe while iterating the field.
+bool BodyField::Spawn(float px, float py, float pvx, float pvy, float r, float lifetime, uint8_t t) {
+    if (pendingCount == spawnCapacity) { dropped++; return false; }
+    pending[pendingCount++] = {px, py, pvx, pvy, r, lifetime, t};
+    return true;
+}
+
+void BodyField::FlushSpawns() {
+    for (int i = 0; i < pendingCount; i++) {
+        const PendingSpawn& s = pending[i];
+        Add(s.x, s.y, s.vx, s.vy, s.radius, s.life, s.tier);
+    }
+    pendingCount = 0;
+}
+
+// Puts allocated-but-inactive slots back on the free list.
+void BodyField::Reclaim() {
+    for (int i = 0; i < span; i++) {
+        if (!active[i] && (gen[i] & 1)) {
+            gen[i]++;
+            freeList[freeCount++] = i;
+            live--;
+        }
+    }
+}
+
+// Slot index for a handle, or -1 if the body has died or been recycled.
+int BodyField::Get(BodyHandle h) const {
+    if (h.index >= (uint32_t)span || gen[h.index] != h.gen || !active[h.index]) return -1;
+    return (int)h.index;
+}
+
+void BodyField::Integrate(float dt, float w, float h, int begin, int end) {
+    if (end < 0 || end > span) end = span;
+    int i = begin;
+#if defined(__AVX__)
+    {
+        const __m256 vdt = _mm256_set1_ps(dt);
+        const __m256 vw = _mm256_set1_ps(w);
+        const __m256 vh = _mm256_set1_ps(h);
+        const __m256 zero = _mm256_setzero_ps();
+        for (; i + 8 <= end; i += 8) {
+            __m256 px = _mm256_add_ps(_mm256_load_ps(x + i), _mm256_mul_ps(_mm256_load_ps(vx + i), vdt));
+            __m256 py = _mm256_add_ps(_mm256_load_ps(y + i), _mm256_mul_ps(_mm256_load_ps(vy + i), vdt));
+            px = _mm256_add_ps(px, _mm256_and_ps(_mm256_cmp_ps(px, zero, _CMP_LT_OQ), vw));
+            px = _mm256_sub_ps(px, _mm256_and_ps(_mm256_cmp_ps(px, vw, _CMP_GT_OQ), vw));
+            py = _mm256_add_ps(py, _mm256_and_ps(_mm256_cmp_ps(py, zero, _CMP_LT_OQ), vh));
+            py = _mm256_sub_ps(py, _mm256_and_ps(_mm256_cmp_ps(py, vh, _CMP_GT_OQ), vh));
+            _mm256_store_ps(x + i, px);
+            _mm256_store_ps(y + i, py);
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    {
+        const __m128 vdt = _mm_set1_ps(dt);
+        const __m128 vw = _mm_set1_ps(w);
+        const __m128 vh = _mm_set1_ps(h);
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= end; i += 4) {
+            __m128 px = _mm_add_ps(_mm_load_ps(x + i), _mm_mul_ps(_mm_load_ps(vx + i), vdt));
+            __m128 py = _mm_add_ps(_mm_load_ps(y + i), _mm_mul_ps(_mm_load_ps(vy + i), vdt));
+            px = _mm_add_ps(px, _mm_and_ps(_mm_cmplt_ps(px, zero), vw));
+            px = _mm_sub_ps(px, _mm_and_ps(_mm_cmpgt_ps(px, vw), vw));
+            py = _mm_add_ps(py, _mm_and_ps(_mm_cmplt_ps(py, zero), vh));
+            py = _mm_sub_ps(py, _mm_and_ps(_mm_cmpgt_ps(py, vh), vh));
+            _mm_store_ps(x + i, px);
+            _mm_store_ps(y + i, py);
+        }
+    }
+#endif
+    for (; i < end; i++) {
+        float px = x[i] + vx[i] * dt;
+        float py = y[i] + vy[i] * dt;
+        if (px < 0) px += w;
+        if (px > w) px -= w;
+        if (py < 0) py += h;
+        if (py > h) py -= h;
+        x[i] = px; y[i] = py;
+    }
+}
+
+void BodyField::Age(float dt) {
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= span; i += 4) {
+        __m128 l = _mm_sub_ps(_mm_load_ps(life + i), vdt);
+        _mm_store_ps(life + i, l);
+        int alive = _mm_movemask_ps(_mm_cmpgt_ps(l, zero));
+        for (int k = 0; k < 4; k++) active[i + k] &= (alive >> k) & 1;
+    }
+#endif
+    for (; i < span; i++) {
+        life[i] -= dt;
+        if (life[i] <= 0) active[i] = 0;
+    }
+}
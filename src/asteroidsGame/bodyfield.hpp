@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+
+// Refers to one body in a BodyField. Goes stale when the slot is recycled.
+struct BodyHandle {
+    uint32_t index;
+    uint32_t gen;
+};
+
+// Fixed-capacity structure-of-arrays pool for the moving circles in
+// Asteroids (rocks and bullets). Every array is 32-byte aligned and padded to
+// a multiple of 8 lanes so the SSE/AVX kernels can use aligned loads.
+//
+// Slots are never moved. Dead slots go back on a free list in Reclaim() and
+// their generation is bumped, which invalidates outstanding handles. Spawns
+// requested while iterating are queued and applied by FlushSpawns(), so the
+// arrays are never resized during a frame.
+class BodyField {
+    private:
+        struct PendingSpawn {
+            float x, y, vx, vy, radius, life;
+            uint8_t tier;
+        };
+
+        int span;           // slots [0, span) have been handed out at least once
+        int capacity;
+        int live;
+        int freeCount;
+        int pendingCount;
+        int spawnCapacity;
+        int dropped;
+        uint32_t* gen;      // odd while the slot is allocated, even while free
+        int* freeList;
+        PendingSpawn* pending;
+
+        void Release();
+
+    public:
+        float* x;
+        float* y;
+        float* vx;
+        float* vy;
+        float* radius;
+        float* life;      // seconds left; only bullets age
+        uint8_t* active;
+        uint8_t* tier;    // AstSize of a rock
+
+        BodyField();
+        ~BodyField();
+        BodyField(const BodyField&) = delete;
+        BodyField& operator=(const BodyField&) = delete;
+
+        // Allocates all storage up front; the only call that allocates.
+        void Init(int maxBodies, int maxPendingSpawns);
+        void Clear();
+
+        BodyHandle Add(float px, float py, float pvx, float pvy, float r, float lifetime, uint8_t t);
+        bool Spawn(float px, float py, float pvx, float pvy, float r, float lifetime, uint8_t t);
+        void FlushSpawns();
+        void Reclaim();
+
+        int Get(BodyHandle h) const;
+        BodyHandle HandleOf(int i) const {return {(uint32_t)i, gen[i]};}
+        int Span() const {return span;}
+        int Live() const {return live;}
+        int Capacity() const {return capacity;}
+        int Dropped() const {return dropped;}
+
+        // pos += vel*dt, then wrap once into [0,w]x[0,h] like WrapPosition.
+        // A sub-range [begin,end) lets workers split the field; begin must be
+        // a multiple of 8 to keep the loads aligned.
+        void Integrate(float dt, float w, float h, int begin = 0, int end = -1);
+        // life -= dt, deactivating anything that runs out
+        void Age(float dt);
+};
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdlib>
+#include <cstring>
+
+// Shared by the SoA containers: arrays are 32-byte aligned (one AVX register)
+// and sized in whole groups of 8 floats, so SIMD loops never need a tail mask.
+static const int LANES = 8;
+static const size_t LANE_ALIGN = 32;
+
+inline int RoundUpLanes(int n) {
+    return ((n + LANES - 1) / LANES) * LANES;
+}
+
+// Zeroed, aligned block of n elements; release with std::free.
+template <typename T>
+T* AllocLanes(int n) {
+    size_t bytes = ((n * sizeof(T) + LANE_ALIGN - 1) / LANE_ALIGN) * LANE_ALIGN;
+    if (bytes == 0) bytes = LANE_ALIGN;
+    T* p = static_cast<T*>(std::aligned_alloc(LANE_ALIGN, bytes));
+    std::memset(p, 0, bytes);
+    return p;
+}
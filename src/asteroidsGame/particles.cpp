@@ -0,0 +1,129 @@
+#include "particles.hpp"
+#include "lanes.hpp"
+#include <rlgl.h>
+#include <cmath>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+static const float STREAK_SECONDS = 0.03f; // drawn tail length, as time along velocity
+
+ParticleSystem::ParticleSystem()
+: capacity(0), head(0), used(0), longest(0), rng(0x9E3779B9u),
+  x(nullptr), y(nullptr), vx(nullptr), vy(nullptr),
+  life(nullptr), invLife(nullptr), color(nullptr) {}
+
+ParticleSystem::~ParticleSystem() {
+    Release();
+}
+
+void ParticleSystem::Release() {
+    std::free(x); std::free(y); std::free(vx); std::free(vy);
+    std::free(life); std::free(invLife); std::free(color);
+    x = y = vx = vy = life = invLife = nullptr;
+    color = nullptr;
+    capacity = 0;
+}
+
+void ParticleSystem::Init(int maxParticles) {
+    Release();
+    capacity = RoundUpLanes(maxParticles);
+    x = AllocLanes<float>(capacity); y = AllocLanes<float>(capacity);
+    vx = AllocLanes<float>(capacity); vy = AllocLanes<float>(capacity);
+    life = AllocLanes<float>(capacity); invLife = AllocLanes<float>(capacity);
+    color = AllocLanes<Color>(capacity);
+    Clear();
+}
+
+void ParticleSystem::Clear() {
+    head = used = 0;
+    longest = 0;
+}
+
+// xorshift32 in [0,1); GetRandomValue is far too slow per particle
+float ParticleSystem::RandomUnit() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (rng >> 8) * (1.0f / 16777216.0f);
+}
+
+void ParticleSystem::Emit(Vector2 pos, Vector2 vel, float lifetime, Color tint) {
+    if (capacity == 0) return;
+    int i = head;
+    x[i] = pos.x; y[i] = pos.y;
+    vx[i] = vel.x; vy[i] = vel.y;
+    life[i] = lifetime; invLife[i] = 1.0f / lifetime;
+    color[i] = tint;
+    if (lifetime > longest) longest = lifetime;
+    head = (head + 1 == capacity) ? 0 : head + 1;
+    if (used < capacity) used++;
+}
+
+void ParticleSystem::Burst(Vector2 pos, int count, float minSpeed, float maxSpeed, float lifetime, Color tint) {
+    for (int i = 0; i < count; i++) {
+        float ang = RandomUnit() * 2 * PI;
+        float speed = minSpeed + (maxSpeed - minSpeed) * RandomUnit();
+        float l = lifetime * (0.5f + 0.5f * RandomUnit());
+        Emit(pos, {cosf(ang) * speed, sinf(ang) * speed}, l, tint);
+    }
+}
+
+void ParticleSystem::Spray(Vector2 pos, Vector2 dir, float halfAngle, int count, float speed, float lifetime, Color tint) {
+    float base = atan2f(dir.y, dir.x);
+    for (int i = 0; i < count; i++) {
+        float ang = base + (RandomUnit() * 2 - 1) * halfAngle;
+        float s = speed * (0.6f + 0.4f * RandomUnit());
+        Emit(pos, {cosf(ang) * s, sinf(ang) * s}, lifetime * (0.5f + 0.5f * RandomUnit()), tint);
+    }
+}
+
+// pos += vel*dt, vel *= damping, life -= dt over every written slot.
+// Dead slots keep ticking; they are skipped when drawing.
+void ParticleSystem::Update(float dt, float drag) {
+    longest -= dt;
+    if (longest <= 0) { Clear(); return; }
+    float damping = 1.0f - drag * dt;
+    if (damping < 0) damping = 0;
+    int n = RoundUpLanes(used);
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 vdamp = _mm_set1_ps(damping);
+    for (; i + 4 <= n; i += 4) {
+        __m128 pvx = _mm_load_ps(vx + i);
+        __m128 pvy = _mm_load_ps(vy + i);
+        _mm_store_ps(x + i, _mm_add_ps(_mm_load_ps(x + i), _mm_mul_ps(pvx, vdt)));
+        _mm_store_ps(y + i, _mm_add_ps(_mm_load_ps(y + i), _mm_mul_ps(pvy, vdt)));
+        _mm_store_ps(vx + i, _mm_mul_ps(pvx, vdamp));
+        _mm_store_ps(vy + i, _mm_mul_ps(pvy, vdamp));
+        _mm_store_ps(life + i, _mm_sub_ps(_mm_load_ps(life + i), vdt));
+    }
+#endif
+    for (; i < n; i++) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        vx[i] *= damping;
+        vy[i] *= damping;
+        life[i] -= dt;
+    }
+}
+
+void ParticleSystem::Draw(float back) const {
+    if (used == 0) return;
+    rlBegin(RL_LINES);
+    for (int i = 0; i < used; i++) {
+        if (life[i] <= 0) continue;
+        Color c = color[i];
+        rlColor4ub(c.r, c.g, c.b, (unsigned char)(c.a * fminf(1.0f, life[i] * invLife[i])));
+        rlVertex2f(x[i] - vx[i] * back, y[i] - vy[i] * back);
+        rlVertex2f(x[i] - vx[i] * (back + STREAK_SECONDS), y[i] - vy[i] * (back + STREAK_SECONDS));
+    }
+    rlEnd();
+}
+
+int ParticleSystem::Live() const {
+    int n = 0;
+    for (int i = 0; i < used; i++) n += life[i] > 0;
+    return n;
+}
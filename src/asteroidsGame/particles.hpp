@@ -0,0 +1,47 @@
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+
+// Fire-and-forget debris and thrust sparks. Particles live in a preallocated
+// ring buffer: emitting overwrites the oldest slot, so nothing is allocated
+// after Init() and a burst can never fail. Update() is an SSE kernel over the
+// used part of the ring, and Draw() submits every live particle as one batch
+// of line segments. Once every particle has run out the ring starts over
+// from slot 0, so a big ring costs nothing between bursts.
+class ParticleSystem {
+    private:
+        int capacity;
+        int head;         // next slot to write
+        int used;         // slots written at least once, up to capacity
+        float longest;    // seconds until every particle has run out
+        uint32_t rng;
+        float* x;
+        float* y;
+        float* vx;
+        float* vy;
+        float* life;      // seconds left
+        float* invLife;   // 1 / starting life, for the fade
+        Color* color;
+
+        float RandomUnit();
+        void Release();
+
+    public:
+        ParticleSystem();
+        ~ParticleSystem();
+        ParticleSystem(const ParticleSystem&) = delete;
+        ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+        void Init(int maxParticles);
+        void Clear();
+        void Emit(Vector2 pos, Vector2 vel, float lifetime, Color tint);
+        // count particles flying out of pos in every direction
+        void Burst(Vector2 pos, int count, float minSpeed, float maxSpeed, float lifetime, Color tint);
+        // count particles in a cone of halfAngle (radians) around dir
+        void Spray(Vector2 pos, Vector2 dir, float halfAngle, int count, float speed, float lifetime, Color tint);
+        void Update(float dt, float drag);
+        // Each particle back seconds along its velocity from where it is
+        void Draw(float back) const;
+        int Capacity() const {return capacity;}
+        int Live() const;
+};
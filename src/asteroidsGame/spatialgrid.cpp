@@ -0,0 +1,77 @@
+#include "spatialgrid.hpp"
+#include <algorithm>
+
+void SpatialGrid::Resize(float worldWidth, float worldHeight, float minCellSize) {
+    width = worldWidth;
+    height = worldHeight;
+    // cells must tile the world exactly or wrapped lookups land in the wrong cell
+    cols = std::max(1, (int)(worldWidth / minCellSize));
+    rows = std::max(1, (int)(worldHeight / minCellSize));
+    cellW = worldWidth / cols;
+    cellH = worldHeight / rows;
+    cellStart.assign(cols * rows + 1, 0);
+    cursor.assign(cols * rows, 0);
+    Clear();
+}
+
+void SpatialGrid::Reserve(int maxItems) {
+    items.reserve(maxItems);
+    pendingCell.reserve(maxItems);
+    pendingId.reserve(maxItems);
+}
+
+void SpatialGrid::Clear() {
+    pendingCell.clear();
+    pendingId.clear();
+    maxRadius = 0;
+}
+
+int SpatialGrid::CellOf(Vector2 pos) const {
+    int cx = WrapIndex((int)floorf(pos.x / cellW), cols);
+    int cy = WrapIndex((int)floorf(pos.y / cellH), rows);
+    return cy * cols + cx;
+}
+
+void SpatialGrid::Add(int id, Vector2 pos, float radius) {
+    pendingCell.push_back(CellOf(pos));
+    pendingId.push_back(id);
+    if (radius > maxRadius) maxRadius = radius;
+}
+
+// Counting sort of the pending items into cells, linear in item count.
+void SpatialGrid::Build() {
+    int cellCount = cols * rows;
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    for (int cell : pendingCell) {
+        cellStart[cell + 1]++;
+    }
+    for (int c = 0; c < cellCount; c++) {
+        cellStart[c + 1] += cellStart[c];
+        cursor[c] = cellStart[c];
+    }
+    items.resize(pendingId.size());
+    for (size_t i = 0; i < pendingId.size(); i++) {
+        items[cursor[pendingCell[i]]++] = pendingId[i];
+    }
+}
+
+// Shortest offset from one point to another on the torus.
+Vector2 SpatialGrid::Delta(Vector2 from, Vector2 to) const {
+    float dx = to.x - from.x;
+    float dy = to.y - from.y;
+    if (dx > width * 0.5f) dx -= width;
+    else if (dx < -width * 0.5f) dx += width;
+    if (dy > height * 0.5f) dy -= height;
+    else if (dy < -height * 0.5f) dy += height;
+    return {dx, dy};
+}
+
+float SpatialGrid::DistanceSqr(Vector2 a, Vector2 b) const {
+    Vector2 d = Delta(a, b);
+    return d.x * d.x + d.y * d.y;
+}
+
+bool SpatialGrid::Overlap(Vector2 a, float ra, Vector2 b, float rb) const {
+    float r = ra + rb;
+    return DistanceSqr(a, b) < r * r;
+}
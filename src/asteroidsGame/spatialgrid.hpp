@@ -0,0 +1,67 @@
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <cmath>
+
+// Uniform grid over a wrapping (toroidal) world. Items are binned by their
+// centre; queries are widened by the largest inserted radius so that every
+// possible overlap is visited, including ones across the screen edges.
+class SpatialGrid {
+    private:
+        int cols;
+        int rows;
+        float width;
+        float height;
+        float cellW;
+        float cellH;
+        float maxRadius;
+        std::vector<int> cellStart;   // cols*rows+1 offsets into items
+        std::vector<int> cursor;      // scatter position per cell during Build
+        std::vector<int> items;       // item ids ordered by cell
+        std::vector<int> pendingCell; // cell of each Add, in call order
+        std::vector<int> pendingId;
+
+        static int WrapIndex(int i, int n) { return ((i % n) + n) % n; }
+        int CellOf(Vector2 pos) const;
+
+    public:
+        SpatialGrid()
+        : cols(1), rows(1), width(1), height(1), cellW(1), cellH(1), maxRadius(0) {};
+        void Resize(float worldWidth, float worldHeight, float minCellSize);
+        // Room for this many items, so Add() and Build() never allocate.
+        void Reserve(int maxItems);
+        void Clear();
+        void Add(int id, Vector2 pos, float radius);
+        void Build();
+        template <typename F> void Query(Vector2 pos, float radius, F&& visit) const;
+        Vector2 Delta(Vector2 from, Vector2 to) const;
+        float DistanceSqr(Vector2 a, Vector2 b) const;
+        bool Overlap(Vector2 a, float ra, Vector2 b, float rb) const;
+        int GetCols() const {return cols;}
+        int GetRows() const {return rows;}
+        int GetCount() const {return (int)items.size();}
+};
+
+// Calls visit(id) for every item whose cell could overlap the circle at pos.
+// Returning true from visit stops the query early.
+template <typename F>
+void SpatialGrid::Query(Vector2 pos, float radius, F&& visit) const {
+    float reach = radius + maxRadius;
+    int x0 = (int)floorf((pos.x - reach) / cellW);
+    int x1 = (int)floorf((pos.x + reach) / cellW);
+    int y0 = (int)floorf((pos.y - reach) / cellH);
+    int y1 = (int)floorf((pos.y + reach) / cellH);
+    // never visit a wrapped cell twice
+    if (x1 - x0 >= cols) x1 = x0 + cols - 1;
+    if (y1 - y0 >= rows) y1 = y0 + rows - 1;
+
+    for (int cy = y0; cy <= y1; cy++) {
+        int rowBase = WrapIndex(cy, rows) * cols;
+        for (int cx = x0; cx <= x1; cx++) {
+            int cell = rowBase + WrapIndex(cx, cols);
+            for (int i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+                if (visit(items[i])) return;
+            }
+        }
+    }
+}
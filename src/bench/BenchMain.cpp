@@ -0,0 +1,68 @@
+#include <raylib.h>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <thread>
+
+#include "../headless/platform.hpp"
+#include "../common/registry.hpp"
+#include "../common/bench.hpp"
+#include "../common/jobs.hpp"
+#include "../common/assetpack.hpp"
+
+// Times the games' hot paths one at a time, each at several sizes, on the
+// headless platform so no window or audio device is needed. The cases come
+// from each game's benchmarks hook; see src/common/bench.hpp.
+//
+//   ArcadeBench [--filter TEXT] [--samples N] [--min-ms MS] [--seed N] [--json FILE]
+//
+// Run it from the repository root, like the launcher, so the games find data/.
+
+static const char* GAMES_MANIFEST = "games.cfg";
+static const char* ASSET_PACK = "build/assets.pak";
+
+int main(int argc, char** argv) {
+    BenchOptions options = {15, 5.0, 1, ""};
+    const char* jsonFile = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            options.samples = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            options.minSampleMs = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonFile = argv[++i];
+        } else {
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (options.samples < 3) { fprintf(stderr, "--samples needs at least 3\n"); return 1; }
+
+    GameRegistry games;
+    if (!games.Load(GAMES_MANIFEST)) { fprintf(stderr, "%s\n", games.Error().c_str()); return 1; }
+    if (!Assets().Open(ASSET_PACK)) fprintf(stderr, "%s; games load data/ files instead\n", Assets().Error().c_str());
+    HeadlessSetScreen(1200, 800);   // the launcher's window
+    Jobs().Start((int)std::thread::hardware_concurrency() - 1);
+
+    BenchSuite suite;
+    for (int g = 0; g < games.Count(); g++) {
+        const GameModule* game = games.Get(g);
+        if (!game) { fprintf(stderr, "%s: %s\n", games.Name(g).c_str(), games.Error().c_str()); return 1; }
+        if (game->benchmarks) game->benchmarks(suite);
+    }
+
+    printf("%d samples per size, seed %llu, %d job workers\n", options.samples, (unsigned long long)options.seed, Jobs().Size());
+    std::vector<BenchResult> results = suite.Run(options);
+    if (results.empty()) { fprintf(stderr, "no benchmark matches %s\n", options.filter.c_str()); return 1; }
+    if (jsonFile && !BenchSuite::WriteJson(jsonFile, options, results)) {
+        fprintf(stderr, "cannot write %s\n", jsonFile);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include "alloctracker.hpp"
+#include "profiler.hpp"
+#include "raylib.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+static_assert(AllocTracker::MAX_ZONES == FrameProfiler::MAX_ZONES, "allocation zones are the profiler's");
+
+// --- Hook ---
+// Plain counters the replaced operators bump; AllocTracker::EndFrame() takes
+// them. Zero before any constructor runs, so allocations made during static
+// initialisation are safe to count.
+namespace {
+    std::atomic<bool> counting(false);
+    std::atomic<long long> allocCount(0), freeCount(0), byteCount(0);
+    std::atomic<long long> zoneAllocCount[AllocTracker::MAX_ZONES];
+    std::atomic<long long> zoneByteCount[AllocTracker::MAX_ZONES];
+    thread_local int allocZone = -1;
+
+    void* Allocate(size_t size) {
+        if (size == 0) size = 1;
+        void* p;
+        while (!(p = malloc(size))) {
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) throw std::bad_alloc();
+            handler();
+        }
+        if (counting.load(std::memory_order_relaxed)) {
+            allocCount.fetch_add(1, std::memory_order_relaxed);
+            byteCount.fetch_add((long long)size, std::memory_order_relaxed);
+            if (allocZone >= 0) {
+                zoneAllocCount[allocZone].fetch_add(1, std::memory_order_relaxed);
+                zoneByteCount[allocZone].fetch_add((long long)size, std::memory_order_relaxed);
+            }
+        }
+        return p;
+    }
+
+    void Release(void* p) {
+        if (!p) return;
+        if (counting.load(std::memory_order_relaxed)) freeCount.fetch_add(1, std::memory_order_relaxed);
+        free(p);
+    }
+}
+
+// The aligned forms are left to the library; nothing here asks for them.
+void* operator new(size_t size) {return Allocate(size);}
+void* operator new[](size_t size) {return Allocate(size);}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try {return Allocate(size);} catch (...) {return nullptr;}
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try {return Allocate(size);} catch (...) {return nullptr;}
+}
+void operator delete(void* p) noexcept {Release(p);}
+void operator delete[](void* p) noexcept {Release(p);}
+void operator delete(void* p, size_t) noexcept {Release(p);}
+void operator delete[](void* p, size_t) noexcept {Release(p);}
+void operator delete(void* p, const std::nothrow_t&) noexcept {Release(p);}
+void operator delete[](void* p, const std::nothrow_t&) noexcept {Release(p);}
+
+int SetAllocZone(int zone) {
+    int outer = allocZone;
+    allocZone = zone >= 0 && zone < AllocTracker::MAX_ZONES ? zone : -1;
+    return outer;
+}
+
+// --- Tracker ---
+AllocTracker& Allocs() {
+    static AllocTracker tracker;
+    return tracker;
+}
+
+AllocTracker::AllocTracker()
+: frames(0), startFrame(0), visible(false), strict(false), counted(false), steady(false), steadyFor(0),
+  strictFrames(0), strictAllocs(0) {
+    memset(frameCounts, 0, sizeof(frameCounts));
+    memset(zoneAllocs, 0, sizeof(zoneAllocs));
+    memset(zoneBytes, 0, sizeof(zoneBytes));
+    ResetTotals();
+}
+
+void AllocTracker::UpdateCounting() {
+    counting.store(Counting(), std::memory_order_relaxed);
+}
+
+void AllocTracker::ResetTotals() {
+    allocCount.store(0, std::memory_order_relaxed);
+    freeCount.store(0, std::memory_order_relaxed);
+    byteCount.store(0, std::memory_order_relaxed);
+    for (int z = 0; z < MAX_ZONES; z++) {
+        zoneAllocCount[z].store(0, std::memory_order_relaxed);
+        zoneByteCount[z].store(0, std::memory_order_relaxed);
+    }
+    total = AllocCounts{};
+    for (int z = 0; z < MAX_ZONES; z++) zoneTotal[z] = AllocCounts{};
+    steadyFor = 0;
+    strictFrames = strictAllocs = 0;
+    startFrame = frames;
+}
+
+void AllocTracker::EndFrame() {
+    AllocCounts counts;
+    counts.allocs = allocCount.exchange(0, std::memory_order_relaxed);
+    counts.frees = freeCount.exchange(0, std::memory_order_relaxed);
+    counts.bytes = byteCount.exchange(0, std::memory_order_relaxed);
+    long long zones[MAX_ZONES];
+    int slot = (int)(frames % HISTORY);
+    frameCounts[slot] = counts;
+    total.allocs += counts.allocs;
+    total.frees += counts.frees;
+    total.bytes += counts.bytes;
+    for (int z = 0; z < MAX_ZONES; z++) {
+        zones[z] = zoneAllocCount[z].exchange(0, std::memory_order_relaxed);
+        long long bytes = zoneByteCount[z].exchange(0, std::memory_order_relaxed);
+        zoneAllocs[z][slot] = zones[z];
+        zoneBytes[z][slot] = bytes;
+        zoneTotal[z].allocs += zones[z];
+        zoneTotal[z].bytes += bytes;
+    }
+    frames++;
+
+    steadyFor = steady ? steadyFor + 1 : 0;
+    steady = false;
+    if (strict && steadyFor > WARMUP_FRAMES && counts.allocs > 0) Report(counts, zones);
+}
+
+void AllocTracker::Report(const AllocCounts& counts, const long long* zones) {
+    strictFrames++;
+    strictAllocs += counts.allocs;
+    if (strictFrames > REPORT_LIMIT) return;
+    const FrameProfiler& profiler = Profiler();
+    // numbered from the game's start, as ResetTotals() marks it
+    fprintf(stderr, "steady-state frame %lld: %lld allocations, %lld bytes (", frames - 1 - startFrame,
+            counts.allocs, counts.bytes);
+    long long tagged = 0;
+    for (int z = 0; z < profiler.ZoneCount(); z++) {
+        if (zones[z] == 0) continue;
+        fprintf(stderr, "%s %lld, ", profiler.ZoneName(z), zones[z]);
+        tagged += zones[z];
+    }
+    fprintf(stderr, "untagged %lld)\n", counts.allocs - tagged);
+    if (strictFrames == REPORT_LIMIT) fprintf(stderr, "further steady-state allocations are only counted\n");
+}
+
+void AllocTracker::Draw(int x, int y) const {
+    const FrameProfiler& profiler = Profiler();
+    int n = Recorded();
+    AllocCounts sum = {}, last = n ? frameCounts[(frames - 1) % HISTORY] : AllocCounts{};
+    long long worst = 0;
+    for (int i = 0; i < n; i++) {
+        sum.allocs += frameCounts[i].allocs;
+        sum.frees += frameCounts[i].frees;
+        sum.bytes += frameCounts[i].bytes;
+        if (frameCounts[i].allocs > worst) worst = frameCounts[i].allocs;
+    }
+    float per = n ? 1.0f / n : 0.0f;
+    const int width = 276;
+    const int height = 62 + profiler.ZoneCount() * 12 + (strict ? 14 : 0);
+    DrawRectangle(x, y, width, height, Fade(BLACK, 0.8f));
+    DrawText(TextFormat("heap  last frame %lld allocs, %lld frees, %lld B", last.allocs, last.frees, last.bytes),
+             x + 10, y + 8, 10, WHITE);
+    DrawText(TextFormat("per frame  %.1f allocs  %.1f frees  %.0f B  max %lld", sum.allocs * per, sum.frees * per,
+             sum.bytes * per, worst), x + 10, y + 22, 10, sum.allocs ? YELLOW : GREEN);
+
+    int ty = y + 40;
+    DrawText("zone", x + 10, ty, 10, GRAY);
+    DrawText("allocs/frame", x + 110, ty, 10, GRAY);
+    DrawText("B/frame", x + 200, ty, 10, GRAY);
+    for (int z = 0; z < profiler.ZoneCount(); z++) {
+        long long allocs = 0, bytes = 0;
+        for (int i = 0; i < n; i++) {
+            allocs += zoneAllocs[z][i];
+            bytes += zoneBytes[z][i];
+        }
+        int ry = ty + 14 + z * 12;
+        DrawText(profiler.ZoneName(z), x + 10, ry, 10, WHITE);
+        DrawText(TextFormat("%.2f", allocs * per), x + 110, ry, 10, allocs ? YELLOW : WHITE);
+        DrawText(TextFormat("%.0f", bytes * per), x + 200, ry, 10, WHITE);
+    }
+    if (strict)
+        DrawText(TextFormat("strict: %lld steady frames allocated, %lld allocs", strictFrames, strictAllocs),
+                 x + 10, ty + 16 + profiler.ZoneCount() * 12, 10, strictFrames ? RED : GREEN);
+}
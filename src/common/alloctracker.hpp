@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+
+// Heap allocation counts per frame. Every host replaces the global operator
+// new and delete (alloctracker.cpp); while counting is on they count calls
+// and bytes, from any thread, into the current frame and into the zone the
+// calling thread is in. The zones are the profiler's: a ProfileScope tags
+// its thread's allocations with its zone until it ends. Counting is off
+// unless the overlay or strict mode is on, and then costs one flag test per
+// call.
+//
+// Strict mode reports, on stderr, every frame that allocates once the game
+// has been in steady state for WARMUP_FRAMES: a host calls SetSteady(true)
+// for each frame of uninterrupted gameplay. Main thread only, apart from
+// the hook itself.
+
+struct AllocCounts {
+    long long allocs;
+    long long frees;
+    long long bytes;                    // asked for by the allocations
+};
+
+class AllocTracker {
+    public:
+        static const int HISTORY = 120;         // frames the overlay averages
+        static const int MAX_ZONES = 16;        // as FrameProfiler::MAX_ZONES
+        static const int WARMUP_FRAMES = 120;
+        static const int REPORT_LIMIT = 20;     // strict reports before going quiet
+
+    private:
+        AllocCounts frameCounts[HISTORY];
+        long long zoneAllocs[MAX_ZONES][HISTORY];
+        long long zoneBytes[MAX_ZONES][HISTORY];
+        AllocCounts total;                      // since ResetTotals()
+        AllocCounts zoneTotal[MAX_ZONES];
+        long long frames;
+        long long startFrame;                   // frames at ResetTotals(), for reports
+        bool visible, strict, counted;
+        bool steady;                            // this frame, as the host said
+        int steadyFor;                          // frames in a row
+        long long strictFrames, strictAllocs;   // allocating frames in steady state
+
+        int Recorded() const {return frames < HISTORY ? (int)frames : HISTORY;}
+        void UpdateCounting();
+        void Report(const AllocCounts& counts, const long long* zones);
+
+    public:
+        AllocTracker();
+
+        void Toggle() {visible = !visible; UpdateCounting();}
+        bool Visible() const {return visible;}
+        void SetStrict(bool on) {strict = on; UpdateCounting();}
+        bool Strict() const {return strict;}
+        // Counting without the overlay or strict mode, for the headless runner.
+        void SetCounting(bool on) {counted = on; UpdateCounting();}
+        bool Counting() const {return visible || strict || counted;}
+        // Whether the frame under way is gameplay; see above.
+        void SetSteady(bool on) {steady = on;}
+
+        // Closes the frame's counts and starts the next.
+        void EndFrame();
+        // Counts since the last ResetTotals(), and for one zone. Resetting
+        // drops the frame under way, and restarts the strict counts and the
+        // warm-up, for a new game.
+        void ResetTotals();
+        AllocCounts Total() const {return total;}
+        AllocCounts ZoneTotal(int zone) const {return zone >= 0 && zone < MAX_ZONES ? zoneTotal[zone] : AllocCounts{};}
+        long long StrictFrames() const {return strictFrames;}
+
+        // Last frame, the averages and each zone's share, top-left at x, y.
+        void Draw(int x, int y) const;
+};
+
+AllocTracker& Allocs();
+
+// Tags this thread's allocations with a profiler zone (-1: none) and returns
+// the tag it had.
+int SetAllocZone(int zone);
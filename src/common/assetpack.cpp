@@ -0,0 +1,121 @@
+#include "assetpack.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <cstring>
+
+AssetPack& Assets() {
+    static AssetPack assets;
+    return assets;
+}
+
+bool AssetPack::Open(const char* fileName) {
+    Close();
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        error = std::string("cannot read ") + fileName;
+        return false;
+    }
+    struct stat st;
+    void* map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(PackHeader))
+        map = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // the mapping keeps the file
+    if (map == MAP_FAILED) {
+        error = std::string("cannot map ") + fileName;
+        return false;
+    }
+    base = (const unsigned char*)map;
+    length = (size_t)st.st_size;
+
+    const PackHeader* header = (const PackHeader*)base;
+    if (memcmp(header->magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 || header->version != PACK_VERSION
+        || header->count > (length - sizeof(PackHeader)) / sizeof(PackEntry)) {
+        Close();
+        error = std::string(fileName) + " is not a version " + std::to_string(PACK_VERSION) + " asset pack";
+        return false;
+    }
+    const PackEntry* list = (const PackEntry*)(base + sizeof(PackHeader));
+    for (uint32_t i = 0; i < header->count; i++) {
+        const PackEntry& e = list[i];
+        uint64_t expected = e.kind == PACK_TEXTURE ? (uint64_t)e.width * e.height * 4
+                          : (uint64_t)e.frameCount * e.channels * 2;
+        if (e.name[sizeof(e.name) - 1] != 0 || e.offset % PACK_ALIGN != 0 || e.size != expected
+            || e.offset > length || e.size > length - e.offset) {
+            Close();
+            error = std::string(fileName) + " is damaged";
+            return false;
+        }
+    }
+    entries = list;
+    count = header->count;
+    // the games will want all of it soon; start paging it in now
+    madvise((void*)base, length, MADV_WILLNEED);
+    error.clear();
+    return true;
+}
+
+void AssetPack::Close() {
+    if (base) munmap((void*)base, length);
+    base = nullptr;
+    length = 0;
+    entries = nullptr;
+    count = 0;
+}
+
+const PackEntry* AssetPack::Find(const char* fileName, PackKind kind, int width, int height) const {
+    for (uint32_t i = 0; i < count; i++) {
+        const PackEntry& e = entries[i];
+        if (e.kind != kind || strcmp(e.name, fileName) != 0) continue;
+        if (width > 0 && height > 0 && ((int)e.width != width || (int)e.height != height)) continue;
+        return &e;
+    }
+    return nullptr;
+}
+
+Texture2D AssetPack::LoadTexture(const char* fileName, int width, int height) {
+    const PackEntry* e = Find(fileName, PACK_TEXTURE, width, height);
+    if (e) {
+        Image image = {};
+        image.data = (void*)(base + e->offset);   // uploaded from the mapping, never written
+        image.width = (int)e->width;
+        image.height = (int)e->height;
+        image.mipmaps = 1;
+        image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+        return LoadTextureFromImage(image);
+    }
+    if (width <= 0 || height <= 0) return ::LoadTexture(fileName);
+    Image image = LoadImage(fileName);
+    ImageResize(&image, width, height);
+    Texture2D texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+    return texture;
+}
+
+Sound AssetPack::LoadSound(const char* fileName) {
+    const PackEntry* e = Find(fileName, PACK_SOUND, 0, 0);
+    if (!e) return ::LoadSound(fileName);
+    Wave wave = {};
+    wave.frameCount = e->frameCount;
+    wave.sampleRate = e->sampleRate;
+    wave.sampleSize = 16;
+    wave.channels = e->channels;
+    wave.data = (void*)(base + e->offset);        // copied into the sound's buffer
+    return LoadSoundFromWave(wave);
+}
+
+Wave AssetPack::LoadWave(const char* fileName) {
+    const PackEntry* e = Find(fileName, PACK_SOUND, 0, 0);
+    if (!e) return ::LoadWave(fileName);
+    Wave wave = {};
+    wave.data = malloc(e->size);                  // raylib's UnloadWave() frees it
+    if (!wave.data) return wave;
+    memcpy(wave.data, base + e->offset, e->size);
+    wave.frameCount = e->frameCount;
+    wave.sampleRate = e->sampleRate;
+    wave.sampleSize = 16;
+    wave.channels = e->channels;
+    return wave;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <string>
+
+// Pre-decoded game assets in one file. ArcadePack (src/packer) decodes every
+// asset listed in assets.cfg once, at build time: images become RGBA8 pixels,
+// already resized where the manifest gives a size, and sounds become 16-bit
+// PCM. The hosts map the pack at startup, and games upload textures and
+// sounds straight from the mapping, so picking a game decodes nothing.
+// Anything missing from the pack is loaded from its file as before.
+
+static const char PACK_MAGIC[8] = {'A', 'R', 'C', 'P', 'A', 'C', 'K', 0};
+static const uint32_t PACK_VERSION = 1;
+static const int PACK_ALIGN = 64;           // every entry's data starts on this
+
+enum PackKind : uint32_t {
+    PACK_TEXTURE = 1,
+    PACK_SOUND = 2
+};
+
+struct PackHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t count;                         // PackEntry records right after
+};
+
+struct PackEntry {
+    char name[96];                          // source path, as games ask for it
+    uint32_t kind;
+    uint32_t width, height;                 // textures, RGBA8
+    uint32_t frameCount, sampleRate;        // sounds, 16-bit
+    uint32_t channels;
+    uint64_t offset;                        // from the start of the file
+    uint64_t size;
+};
+
+class AssetPack {
+    private:
+        const unsigned char* base;
+        size_t length;
+        const PackEntry* entries;
+        uint32_t count;
+        std::string error;
+
+        const PackEntry* Find(const char* fileName, PackKind kind, int width, int height) const;
+
+    public:
+        AssetPack() : base(nullptr), length(0), entries(nullptr), count(0) {};
+        ~AssetPack() {Close();}
+        AssetPack(const AssetPack&) = delete;
+        AssetPack& operator=(const AssetPack&) = delete;
+
+        // Maps the pack read-only. False if it is missing or malformed, see
+        // Error(); the games then load every file themselves.
+        bool Open(const char* fileName);
+        void Close();
+        int Count() const {return (int)count;}
+        const std::string& Error() const {return error;}
+
+        // fileName at its own size, or at width x height when both are given.
+        Texture2D LoadTexture(const char* fileName, int width = 0, int height = 0);
+        Sound LoadSound(const char* fileName);
+        // Decoded samples the caller owns and frees with UnloadWave(), for
+        // building several sounds from one decode. From the pack they are a
+        // copy of the mapped PCM.
+        Wave LoadWave(const char* fileName);
+};
+
+AssetPack& Assets();
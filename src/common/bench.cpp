@@ -0,0 +1,110 @@
+#include "bench.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+// Calibration stops doubling here even if a run is still too quick to time
+static const int MAX_RUNS_PER_SAMPLE = 1 << 24;
+// MAD of a normal distribution, in standard deviations
+static const double MAD_TO_SIGMA = 1.4826;
+
+static volatile uint64_t sink;
+
+void BenchSink(uint64_t value) {
+    sink = sink + value;
+}
+
+static double NowNs() {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static double TimeRuns(const BenchCase& c, int runs) {
+    double start = NowNs();
+    for (int r = 0; r < runs; r++) c.run();
+    return NowNs() - start;
+}
+
+static double Median(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    size_t n = v.size();
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+BenchResult BenchSuite::Measure(const BenchCase& c, int size, const BenchOptions& options) {
+    c.setup(size, options.seed);
+
+    // warm up, then double the runs until a sample is long enough to time
+    int runs = 1;
+    double minNs = options.minSampleMs * 1e6;
+    while (TimeRuns(c, runs) < minNs && runs < MAX_RUNS_PER_SAMPLE) runs *= 2;
+
+    std::vector<double> perRun(options.samples);
+    for (int s = 0; s < options.samples; s++) perRun[s] = TimeRuns(c, runs) / runs;
+    if (c.teardown) c.teardown();
+
+    double median = Median(perRun);
+    std::vector<double> deviation(perRun.size());
+    for (size_t i = 0; i < perRun.size(); i++) deviation[i] = fabs(perRun[i] - median);
+    double limit = OUTLIER_MADS * MAD_TO_SIGMA * Median(deviation);
+
+    BenchResult r = {c.name, c.sizeUnit, size, runs, 0, 0, median, 0, 0, 0};
+    double sum = 0, sumSq = 0;
+    for (double ns : perRun) {
+        // with no spread at all, keep everything
+        if (limit > 0 && fabs(ns - median) > limit) { r.rejected++; continue; }
+        r.samples++;
+        sum += ns;
+        sumSq += ns * ns;
+        // from kept samples only: a rejected warm-up spike or dip is not the minimum
+        r.minNs = r.samples == 1 ? ns : std::min(r.minNs, ns);
+    }
+    r.meanNs = sum / r.samples;
+    r.stddevNs = sqrt(std::max(0.0, sumSq / r.samples - r.meanNs * r.meanNs));
+    return r;
+}
+
+std::vector<BenchResult> BenchSuite::Run(const BenchOptions& options) {
+    std::vector<BenchResult> results;
+    printf("%-28s %10s %8s %14s %14s %10s %5s\n", "case", "size", "runs", "median ns", "mean ns", "stddev %", "out");
+    for (const BenchCase& c : cases) {
+        if (!options.filter.empty() && c.name.find(options.filter) == std::string::npos) continue;
+        for (int size : c.sizes) {
+            BenchResult r = Measure(c, size, options);
+            printf("%-28s %10d %8d %14.1f %14.1f %10.1f %5d\n", r.name.c_str(), r.size, r.runsPerSample,
+                   r.medianNs, r.meanNs, r.meanNs > 0 ? 100.0 * r.stddevNs / r.meanNs : 0.0, r.rejected);
+            fflush(stdout);
+            results.push_back(r);
+        }
+    }
+    return results;
+}
+
+static void WriteJsonString(FILE* f, const std::string& s) {
+    fputc('"', f);
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') fputc('\\', f);
+        fputc(ch, f);
+    }
+    fputc('"', f);
+}
+
+bool BenchSuite::WriteJson(const char* fileName, const BenchOptions& options, const std::vector<BenchResult>& results) {
+    FILE* f = fopen(fileName, "w");
+    if (!f) return false;
+    fprintf(f, "{\n  \"seed\": %llu,\n  \"samples\": %d,\n  \"min_sample_ms\": %g,\n  \"outlier_mads\": %g,\n  \"results\": [",
+            (unsigned long long)options.seed, options.samples, options.minSampleMs, OUTLIER_MADS);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        fprintf(f, "%s\n    {\"name\": ", i ? "," : "");
+        WriteJsonString(f, r.name);
+        fprintf(f, ", \"size\": %d, \"size_unit\": ", r.size);
+        WriteJsonString(f, r.sizeUnit);
+        fprintf(f, ", \"runs_per_sample\": %d, \"samples\": %d, \"rejected\": %d, "
+                   "\"median_ns\": %.1f, \"mean_ns\": %.1f, \"min_ns\": %.1f, \"stddev_ns\": %.1f}",
+                r.runsPerSample, r.samples, r.rejected, r.medianNs, r.meanNs, r.minNs, r.stddevNs);
+    }
+    fprintf(f, "\n  ]\n}\n");
+    return fclose(f) == 0;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Microbenchmarks for the games' hot paths. A module adds cases to the suite
+// from its GameModule::benchmarks hook; ArcadeBench (src/bench) runs them.
+// Each case runs at every size it lists:
+//  - setup(size, seed) builds the state untimed, from the fixed seed;
+//  - run() is the timed work, repeated until a sample is long enough to time;
+//  - teardown() puts the game back as the module expects it.
+// Samples further than OUTLIER_MADS median absolute deviations from the
+// median are dropped before the mean and spread are taken.
+struct BenchCase {
+    std::string name;           // "game/what", used by --filter
+    std::string sizeUnit;       // what size counts: "cells", "rocks", ...
+    std::vector<int> sizes;
+    std::function<void(int size, uint64_t seed)> setup;
+    std::function<void()> run;
+    std::function<void()> teardown;
+};
+
+struct BenchOptions {
+    int samples;                // timed samples per size
+    double minSampleMs;         // runs per sample are raised until one takes this long
+    uint64_t seed;
+    std::string filter;         // substring of the case name; empty runs all
+};
+
+struct BenchResult {
+    std::string name;
+    std::string sizeUnit;
+    int size;
+    int runsPerSample;
+    int samples;                // kept after outlier rejection
+    int rejected;
+    double medianNs;            // per run
+    double meanNs;
+    double minNs;
+    double stddevNs;
+};
+
+class BenchSuite {
+    public:
+        static constexpr double OUTLIER_MADS = 3.0;
+
+    private:
+        std::vector<BenchCase> cases;
+
+        BenchResult Measure(const BenchCase& c, int size, const BenchOptions& options);
+
+    public:
+        void Add(BenchCase c) {cases.push_back(std::move(c));}
+        int Count() const {return (int)cases.size();}
+        // Runs every matching case at every size, printing a line per result.
+        std::vector<BenchResult> Run(const BenchOptions& options);
+        static bool WriteJson(const char* fileName, const BenchOptions& options, const std::vector<BenchResult>& results);
+};
+
+// Keeps a benchmark's result alive so the work is not optimised away.
+void BenchSink(uint64_t value);
@@ -0,0 +1,89 @@
+#include "framepacer.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+// Sleep until this close to the wake-up point, then spin: the OS may
+// oversleep by a millisecond or more
+static const double SPIN_NS = 1.5e6;
+
+static uint64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void SleepUntil(uint64_t when) {
+    uint64_t now = NowNs();
+    if (when > now + SPIN_NS) std::this_thread::sleep_for(std::chrono::nanoseconds((uint64_t)(when - now - SPIN_NS)));
+    while (NowNs() < when) std::this_thread::yield();
+}
+
+FramePacer::FramePacer()
+: latency(false), period(1.0 / 60), startedAt(0), submittedAt(0), presentedAt(0), deadline(0), frames(0) {}
+
+double FramePacer::WorstWorkMs() const {
+    float worst = 0;
+    for (int i = 0; i < Recorded(); i++) worst = std::max(worst, workMs[i]);
+    return worst;
+}
+
+void FramePacer::PollInput() {
+    uint64_t periodNs = (uint64_t)(period * 1e9);
+    uint64_t wake = 0;
+    if (latency && presentedAt) {
+        // deadlines a period apart; a present that came after its deadline,
+        // held back by vsync or a long frame, moves them to follow it
+        deadline = presentedAt >= deadline ? presentedAt + periodNs : deadline + periodNs;
+        uint64_t lead = (uint64_t)((WorstWorkMs() + MARGIN_MS) * 1e6);
+        wake = deadline - std::min(lead, periodNs);
+    } else if (startedAt) {
+        wake = startedAt + periodNs;
+    }
+    // a frame that ran long starts the next one now rather than catching up
+    SleepUntil(std::max(wake, NowNs()));
+    PollInputEvents();
+    startedAt = NowNs();
+}
+
+void FramePacer::Submit() {
+    submittedAt = NowNs();
+}
+
+void FramePacer::Presented() {
+    uint64_t now = NowNs();
+    int slot = (int)(frames % HISTORY);
+    workMs[slot] = (submittedAt - startedAt) / 1e6f;
+    intervalMs[slot] = presentedAt ? (now - presentedAt) / 1e6f : (float)(period * 1e3);
+    lagMs[slot] = (now - startedAt) / 1e6f;
+    presentedAt = now;
+    frames++;
+}
+
+void FramePacer::Figures(float& intervalMean, float& jitter, float& worstLate, float& inputToPresent) const {
+    int n = Recorded();
+    intervalMean = jitter = worstLate = inputToPresent = 0;
+    if (n == 0) return;
+    double sum = 0, sumSq = 0, lag = 0, worst = 0;
+    for (int i = 0; i < n; i++) {
+        sum += intervalMs[i];
+        sumSq += (double)intervalMs[i] * intervalMs[i];
+        lag += lagMs[i];
+        worst = std::max(worst, (double)intervalMs[i]);
+    }
+    intervalMean = (float)(sum / n);
+    jitter = (float)sqrt(std::max(0.0, sumSq / n - intervalMean * (double)intervalMean));
+    worstLate = (float)std::max(0.0, worst - period * 1e3);
+    inputToPresent = (float)(lag / n + period * 1e3 / 2);
+}
+
+void FramePacer::Draw(int x, int y) const {
+    float mean, jitter, late, lag;
+    Figures(mean, jitter, late, lag);
+    DrawRectangle(x, y, 276, PANEL_H, Fade(BLACK, 0.8f));
+    DrawText(TextFormat("pacing %s (F7)  target %.1f ms", latency ? "latency" : "default", period * 1e3), x + 10, y + 8, 10, WHITE);
+    DrawText(TextFormat("interval %.2f  jitter %.2f  late %.1f ms", mean, jitter, late), x + 10, y + 22, 10, WHITE);
+    DrawText(TextFormat("input to present ~%.1f  work %.1f ms", lag, WorstWorkMs()), x + 10, y + 36, 10,
+             lag > period * 1e3 * 1.5 ? YELLOW : GREEN);
+}
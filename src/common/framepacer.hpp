@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+
+// Owns the launcher's frame limiter: when each frame starts, when input is
+// sampled for it, and how well the presents are paced. raylib's limiter
+// (SetTargetFPS) is kept off. Each frame starts with PollInput():
+//  - default mode sleeps until a period after the previous frame started,
+//    then polls, as raylib's limiter does. Under vsync the present then
+//    waits for the next vblank, so input is about a frame old when shown;
+//  - latency mode sleeps until just before the next present is due, leaving
+//    the recent worst poll-to-submit time plus MARGIN_MS, then polls, so the
+//    frame is simulated on input sampled as late as it can be. Run it with
+//    vsync, so the present itself lands on the deadline.
+// It keeps the present-to-present jitter and an input-to-present estimate:
+// poll to present, plus the half period a key waits for the next poll on
+// average.
+//
+// raylib also polls at the end of EndDrawing(), so raylib's pressed flags
+// only cover the interval between the two polls; read presses through
+// Session(), which latches what EndDrawing() saw (GameSession::Latch()).
+class FramePacer {
+    public:
+        static const int HISTORY = 120;         // frames the figures cover
+        static constexpr double MARGIN_MS = 1.0;
+        static const int PANEL_H = 50;          // Draw()'s height
+
+    private:
+        bool latency;
+        double period;                          // seconds per frame
+        uint64_t startedAt;                     // frame start, right after the poll
+        uint64_t submittedAt, presentedAt;
+        uint64_t deadline;                      // latency mode: when the present is due
+        float workMs[HISTORY];                  // poll to submit
+        float intervalMs[HISTORY];              // present to present
+        float lagMs[HISTORY];                   // poll to present
+        long long frames;
+
+        int Recorded() const {return frames < HISTORY ? (int)frames : HISTORY;}
+        double WorstWorkMs() const;
+
+    public:
+        FramePacer();
+
+        void SetLatency(bool on) {latency = on;}
+        bool Latency() const {return latency;}
+        void SetRate(int fps) {period = fps > 0 ? 1.0 / fps : 1.0 / 60;}
+
+        // Top of the frame: sleeps until it is due and polls input.
+        void PollInput();
+        // Right before EndDrawing().
+        void Submit();
+        // Right after EndDrawing().
+        void Presented();
+
+        // Interval mean and jitter (standard deviation), worst miss of the
+        // deadline and the input-to-present estimate, all in ms.
+        void Figures(float& intervalMean, float& jitter, float& worstLate, float& inputToPresent) const;
+        // Panel with the figures, top-left at x, y.
+        void Draw(int x, int y) const;
+};
@@ -0,0 +1,243 @@
+#include "jobs.hpp"
+#include "raylib.h"
+#include <chrono>
+#include <algorithm>
+
+static const double SAMPLE_SECONDS = 0.5;   // overlay refresh
+static const int PANEL_W = 420;
+
+// Which system this thread works for, and as which worker
+static thread_local const JobSystem* tlsSystem = nullptr;
+static thread_local int tlsWorker = -1;
+// Jobs run inside jobs (a wait inside a job) count towards the outer one
+static thread_local int tlsDepth = 0;
+
+static uint64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+JobSystem& Jobs() {
+    static JobSystem jobs;
+    return jobs;
+}
+
+JobSystem::JobSystem()
+: queued(0), peakQueued(0), nextOutside(0), quit(false), sampledAt(NowNs()), shown() {
+    workers.emplace_back(new Worker());
+}
+
+void JobSystem::Start(int extraThreads) {
+    Stop();
+    extraThreads = std::max(0, std::min(extraThreads, MAX_WORKERS - 1));
+    quit = false;
+    tlsSystem = this;
+    tlsWorker = 0;
+    for (int i = 0; i < extraThreads; i++) workers.emplace_back(new Worker());
+    for (int i = 1; i <= extraThreads; i++) threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+    sampledAt = NowNs();
+}
+
+void JobSystem::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMtx);
+        quit = true;
+    }
+    wake.notify_all();
+    for (auto& t : threads) t.join();
+    threads.clear();
+    workers.resize(1);
+}
+
+int JobSystem::Self() const {
+    return tlsSystem == this ? tlsWorker : -1;
+}
+
+// Adds as many of jobs as fit to the back of worker's ring; returns how many.
+int JobSystem::Append(int worker, const Job* jobs, int count) {
+    Worker& w = *workers[worker];
+    std::lock_guard<std::mutex> lock(w.mtx);
+    int added = std::min(count, QUEUE_CAPACITY - w.count);
+    for (int i = 0; i < added; i++) w.ring[(w.front + w.count + i) % QUEUE_CAPACITY] = jobs[i];
+    w.count += added;
+    return added;
+}
+
+void JobSystem::Push(int worker, const Job* jobs, int count) {
+    if (count <= 0) return;
+    // nobody else to run them
+    if (threads.empty()) {
+        for (int i = 0; i < count; i++) Execute(0, jobs[i]);
+        return;
+    }
+    int self = worker;
+    if (worker < 0) worker = (int)(nextOutside.fetch_add(1, std::memory_order_relaxed) % workers.size());
+    int added = 0;
+    while (added < count) {
+        // the target's ring first, then the others'
+        int round = 0;
+        for (int k = 0; k < Size() && added + round < count; k++)
+            round += Append((worker + k) % Size(), jobs + added + round, count - added - round);
+        if (round > 0) {
+            added += round;
+            int depth = queued.fetch_add(round) + round;
+            int peak = peakQueued.load(std::memory_order_relaxed);
+            while (depth > peak && !peakQueued.compare_exchange_weak(peak, depth)) {}
+            { std::lock_guard<std::mutex> lock(sleepMtx); }
+            if (round == 1) wake.notify_one();
+            else wake.notify_all();
+        }
+        if (added == count) break;
+        // every ring is full: a worker runs the next one itself, anyone else waits for room
+        if (self >= 0) Execute(self, jobs[added++]);
+        else std::this_thread::yield();
+    }
+}
+
+bool JobSystem::Take(int self, Job& job) {
+    int n = (int)workers.size();
+    {
+        Worker& own = *workers[self];
+        std::lock_guard<std::mutex> lock(own.mtx);
+        if (own.count > 0) {
+            job = own.ring[(own.front + --own.count) % QUEUE_CAPACITY];
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    for (int k = 1; k < n; k++) {
+        Worker& victim = *workers[(self + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mtx);
+        if (victim.count == 0) continue;
+        job = victim.ring[victim.front];
+        victim.front = (victim.front + 1) % QUEUE_CAPACITY;
+        victim.count--;
+        queued.fetch_sub(1);
+        workers[self]->steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(int self, const Job& job) {
+    uint64_t start = tlsDepth == 0 ? NowNs() : 0;
+    tlsDepth++;
+    job.fn(job.ctx, job.begin, job.end, self);
+    tlsDepth--;
+    Worker& w = *workers[self];
+    if (tlsDepth == 0) w.busyNs.fetch_add(NowNs() - start, std::memory_order_relaxed);
+    w.jobsRun.fetch_add(1, std::memory_order_relaxed);
+    Finish(job.counter);
+}
+
+void JobSystem::Finish(JobCounter* counter) {
+    if (!counter) return;
+    std::vector<Job> ready;
+    bool last;
+    {
+        // under the lock, so a RunAfter() either sees zero or gets released here
+        std::lock_guard<std::mutex> lock(counter->mtx);
+        last = counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        if (last) ready.swap(counter->held);
+    }
+    // counter may be gone from here on
+    if (last && !threads.empty()) {
+        { std::lock_guard<std::mutex> lock(sleepMtx); }
+        finished.notify_all();
+    }
+    for (const Job& job : ready) Push(Self(), &job, 1);
+}
+
+void JobSystem::Queue(const Job& job, JobCounter* after) {
+    if (after) {
+        std::lock_guard<std::mutex> lock(after->mtx);
+        if (!after->Done()) { after->held.push_back(job); return; }
+    }
+    Push(Self(), &job, 1);
+}
+
+void JobSystem::Split(JobFn fn, void* ctx, int n, int grain) {
+    if (n <= 0) return;
+    grain = std::max(1, grain);
+    // one chunk, or nobody to share with: no point queueing
+    if (threads.empty() || n <= grain) { Execute(std::max(0, Self()), {fn, ctx, 0, n, nullptr}); return; }
+    // chunks go out a batch at a time from the stack, so a split never allocates
+    JobCounter counter;
+    counter.pending.store((n + grain - 1) / grain, std::memory_order_relaxed);
+    Job batch[SPLIT_BATCH];
+    int batched = 0;
+    for (int begin = 0; begin < n; begin += grain) {
+        batch[batched++] = {fn, ctx, begin, std::min(n, begin + grain), &counter};
+        if (batched == SPLIT_BATCH) { Push(Self(), batch, batched); batched = 0; }
+    }
+    Push(Self(), batch, batched);
+    Wait(counter);
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    int self = Self();
+    if (self < 0) {
+        // jobs are handed a worker index, so only workers may run them
+        std::unique_lock<std::mutex> lock(sleepMtx);
+        finished.wait(lock, [&] { return counter.Done(); });
+    }
+    while (!counter.Done()) {
+        Job job;
+        if (Take(self, job)) Execute(self, job);
+        else std::this_thread::yield();
+    }
+    // the last Finish() may still be unlocking it
+    std::lock_guard<std::mutex> lock(counter.mtx);
+}
+
+void JobSystem::WorkerLoop(int worker) {
+    tlsSystem = this;
+    tlsWorker = worker;
+    for (;;) {
+        Job job;
+        if (Take(worker, job)) { Execute(worker, job); continue; }
+        std::unique_lock<std::mutex> lock(sleepMtx);
+        wake.wait(lock, [&] { return quit || queued.load() > 0; });
+        if (quit) return;
+    }
+}
+
+JobStats JobSystem::Sample() {
+    uint64_t now = NowNs();
+    double span = (double)(now - sampledAt);
+    sampledAt = now;
+    JobStats s = {};
+    s.workers = Size();
+    s.queued = queued.load();
+    s.peakQueued = peakQueued.exchange(s.queued);
+    s.seconds = span / 1e9;
+    for (int w = 0; w < s.workers; w++) {
+        Worker& k = *workers[w];
+        long long busy = k.busyNs.load(), jobs = k.jobsRun.load(), steals = k.steals.load();
+        s.busy[w] = span > 0 ? (float)std::min(1.0, (busy - k.sampledBusyNs) / span) : 0.0f;
+        s.jobs += jobs - k.sampledJobs;
+        s.steals += steals - k.sampledSteals;
+        k.sampledBusyNs = busy;
+        k.sampledJobs = jobs;
+        k.sampledSteals = steals;
+    }
+    return s;
+}
+
+void JobSystem::Draw(int x, int y) {
+    if (shown.workers == 0 || (NowNs() - sampledAt) / 1e9 >= SAMPLE_SECONDS) shown = Sample();
+    const int barW = 100;
+    int height = 30 + shown.workers * 12;
+    DrawRectangle(x, y, PANEL_W, height, Fade(BLACK, 0.8f));
+    double perSec = shown.seconds > 0 ? 1.0 / shown.seconds : 0.0;
+    DrawText(TextFormat("jobs  %d workers  queued %d (peak %d)  %.0f jobs/s  %.0f steals/s", shown.workers,
+             shown.queued, shown.peakQueued, shown.jobs * perSec, shown.steals * perSec), x + 10, y + 8, 10, WHITE);
+    for (int w = 0; w < shown.workers; w++) {
+        int ry = y + 24 + w * 12;
+        float busy = shown.busy[w];
+        DrawText(TextFormat("%2d", w), x + 10, ry, 10, GRAY);
+        DrawRectangle(x + 30, ry + 1, barW, 8, DARKGRAY);
+        DrawRectangle(x + 30, ry + 1, (int)(busy * barW), 8, busy > 0.9f ? RED : (busy > 0.5f ? YELLOW : GREEN));
+        DrawText(TextFormat("%3.0f%%", busy * 100.0f), x + 36 + barW, ry, 10, WHITE);
+    }
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+// Work-stealing job scheduler shared by every game. Each host starts it once
+// (Jobs()); the thread that starts it is worker 0 and runs jobs whenever it
+// waits on them. Every worker has its own queue, a fixed ring: it pushes and
+// pops at the back, so it works through what it just split up while it is
+// still in cache, and idle workers steal from the front of the others'. A
+// pusher that finds every ring full runs the job itself, so queueing never
+// allocates. A system that was never started runs everything inline on the
+// caller, as worker 0.
+
+typedef void (*JobFn)(void* ctx, int begin, int end, int worker);
+
+struct Job {
+    JobFn fn;
+    void* ctx;
+    int begin;
+    int end;
+    class JobCounter* counter;
+};
+
+// Jobs queued against a counter raise it and drop it when they finish.
+// Wait() on it returns at zero, and jobs queued to run after it are held
+// back until then. Reusable once it is back at zero.
+class JobCounter {
+    private:
+        friend class JobSystem;
+        std::atomic<int> pending;
+        std::mutex mtx;
+        std::vector<Job> held;   // RunAfter() jobs waiting for zero
+
+    public:
+        JobCounter() : pending(0) {};
+        bool Done() const {return pending.load(std::memory_order_acquire) == 0;}
+};
+
+struct JobStats {
+    static const int MAX_WORKERS = 64;
+    int workers;
+    int queued;                 // waiting in the queues now
+    int peakQueued;             // most waiting at once over the sample
+    long long jobs;             // finished over the sample
+    long long steals;           // of those, taken from another worker's deque
+    double seconds;             // length of the sample
+    float busy[MAX_WORKERS];    // share of the sample each worker spent in jobs
+};
+
+class JobSystem {
+    public:
+        static const int MAX_WORKERS = JobStats::MAX_WORKERS;
+        static const int QUEUE_CAPACITY = 1024;        // jobs per worker
+
+    private:
+        static const int SPLIT_BATCH = 64;              // chunks Split() queues at a time
+
+        struct Worker {
+            std::mutex mtx;
+            Job ring[QUEUE_CAPACITY];
+            int front;                                  // oldest job's slot
+            int count;
+            std::atomic<long long> busyNs;
+            std::atomic<long long> jobsRun;
+            std::atomic<long long> steals;
+            long long sampledBusyNs, sampledJobs, sampledSteals; // at the last Sample()
+            Worker() : front(0), count(0), busyNs(0), jobsRun(0), steals(0), sampledBusyNs(0), sampledJobs(0), sampledSteals(0) {};
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers;   // [0] started the system
+        std::vector<std::thread> threads;
+        std::mutex sleepMtx;
+        std::condition_variable wake;
+        std::condition_variable finished;               // a counter reached zero, for Wait() off the workers
+        std::atomic<int> queued;
+        std::atomic<int> peakQueued;
+        std::atomic<unsigned> nextOutside;              // round robin for pushes from other threads
+        bool quit;
+        uint64_t sampledAt;
+        JobStats shown;                                 // what Draw() shows, refreshed twice a second
+
+        int Self() const;
+        int Append(int worker, const Job* jobs, int count);
+        void Push(int worker, const Job* jobs, int count);
+        bool Take(int self, Job& job);
+        void Execute(int self, const Job& job);
+        void Finish(JobCounter* counter);
+        void WorkerLoop(int worker);
+        void Queue(const Job& job, JobCounter* after);
+
+    public:
+        JobSystem();
+        ~JobSystem() {Stop();}
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // Worker 0 is the calling thread; extraThreads more are started.
+        void Start(int extraThreads);
+        // Call with no jobs outstanding.
+        void Stop();
+        int Size() const {return (int)workers.size();}
+
+        // Calls fn(begin, end, worker) over [0,n) in chunks of grain and
+        // returns once every chunk is done. worker is in [0, Size()).
+        template <typename F>
+        void ParallelFor(int n, int grain, F& fn) {
+            Split([](void* ctx, int b, int e, int w) { (*static_cast<F*>(ctx))(b, e, w); }, &fn, n, grain);
+        }
+        void Split(JobFn fn, void* ctx, int n, int grain);
+
+        // Queues fn(worker) as one job counted by counter; fn must outlive it.
+        template <typename F>
+        void Run(F& fn, JobCounter& counter) {
+            RunAfter(nullptr, fn, counter);
+        }
+        // As Run, but held back until after (if any) reaches zero.
+        template <typename F>
+        void RunAfter(JobCounter* after, F& fn, JobCounter& counter) {
+            counter.pending.fetch_add(1, std::memory_order_relaxed);
+            Queue({[](void* ctx, int, int, int w) { (*static_cast<F*>(ctx))(w); }, &fn, 0, 0, &counter}, after);
+        }
+        // Returns once counter is at zero. Workers run queued jobs meanwhile;
+        // any other thread sleeps until a counter finishes.
+        void Wait(JobCounter& counter);
+
+        // Queue depth, jobs and per-worker busy time since the previous
+        // call. Sample() and Draw() are for one thread, usually the main one.
+        JobStats Sample();
+        // Busy bars per worker, queue depth and throughput, top-left at x, y.
+        void Draw(int x, int y);
+};
+
+JobSystem& Jobs();
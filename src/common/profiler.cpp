@@ -0,0 +1,106 @@
+#include "profiler.hpp"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+
+// Graph scale and the budget line drawn across it
+static const float GRAPH_MAX_MS = 50.0f;
+static const float BUDGET_MS = 1000.0f / 60.0f;
+
+FrameProfiler& Profiler() {
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+FrameProfiler::FrameProfiler()
+: zoneCount(0), frames(0), frameStart(Now()), visible(false) {
+    memset(current, 0, sizeof(current));
+    memset(zoneMs, 0, sizeof(zoneMs));
+    memset(frameMs, 0, sizeof(frameMs));
+}
+
+int FrameProfiler::Zone(const char* name) {
+    for (int z = 0; z < zoneCount; z++)
+        if (strcmp(zoneNames[z], name) == 0) return z;
+    if (zoneCount == MAX_ZONES) return -1;
+    zoneNames[zoneCount] = name;
+    return zoneCount++;
+}
+
+void FrameProfiler::EndFrame() {
+    uint64_t now = Now();
+    int slot = (int)(frames % HISTORY);
+    frameMs[slot] = (now - frameStart) / 1e6f;
+    for (int z = 0; z < zoneCount; z++) {
+        zoneMs[z][slot] = current[z] / 1e6f;
+        current[z] = 0;
+    }
+    frames++;
+    frameStart = now;
+}
+
+float FrameProfiler::Percentile(float p) const {
+    int n = Recorded();
+    if (n == 0) return 0.0f;
+    float sorted[HISTORY];
+    std::copy(frameMs, frameMs + n, sorted);
+    int k = std::min(n - 1, (int)(p / 100.0f * n));
+    std::nth_element(sorted, sorted + k, sorted + n);
+    return sorted[k];
+}
+
+void FrameProfiler::Draw(int x, int y) const {
+    const int graphH = 100;
+    const int width = HISTORY + 20;
+    const int height = 60 + graphH + zoneCount * 18;
+    DrawRectangle(x, y, width, height, Fade(BLACK, 0.8f));
+    DrawText(TextFormat("frame ms  p50 %.1f  p95 %.1f  p99 %.1f", Percentile(50), Percentile(95), Percentile(99)),
+             x + 10, y + 8, 10, WHITE);
+
+    // newest frame on the right
+    int gx = x + 10, gy = y + 28;
+    int n = Recorded();
+    for (int i = 0; i < n; i++) {
+        float ms = frameMs[(frames - n + i) % HISTORY];
+        int h = (int)(std::min(ms, GRAPH_MAX_MS) / GRAPH_MAX_MS * graphH);
+        Color c = ms <= BUDGET_MS * 1.05f ? GREEN : (ms <= 2.0f * BUDGET_MS ? YELLOW : RED);
+        DrawLine(gx + HISTORY - n + i, gy + graphH, gx + HISTORY - n + i, gy + graphH - h, c);
+    }
+    int budgetY = gy + graphH - (int)(BUDGET_MS / GRAPH_MAX_MS * graphH);
+    DrawLine(gx, budgetY, gx + HISTORY, budgetY, Fade(WHITE, 0.5f));
+    DrawText("16.7", gx + HISTORY - 22, budgetY - 11, 10, Fade(WHITE, 0.5f));
+
+    // per-zone average and worst over the same frames
+    int ty = gy + graphH + 10;
+    DrawText("zone", x + 10, ty, 10, GRAY);
+    DrawText("avg ms", x + 150, ty, 10, GRAY);
+    DrawText("max ms", x + 210, ty, 10, GRAY);
+    for (int z = 0; z < zoneCount; z++) {
+        float sum = 0, worst = 0;
+        for (int i = 0; i < n; i++) {
+            sum += zoneMs[z][i];
+            worst = std::max(worst, zoneMs[z][i]);
+        }
+        int ry = ty + 16 + z * 18;
+        DrawText(zoneNames[z], x + 10, ry, 10, WHITE);
+        DrawText(TextFormat("%.2f", n ? sum / n : 0.0f), x + 150, ry, 10, WHITE);
+        DrawText(TextFormat("%.2f", worst), x + 210, ry, 10, WHITE);
+    }
+}
+
+bool FrameProfiler::ExportCsv(const char* fileName) const {
+    FILE* f = fopen(fileName, "w");
+    if (!f) return false;
+    fprintf(f, "frame,total_ms");
+    for (int z = 0; z < zoneCount; z++) fprintf(f, ",%s_ms", zoneNames[z]);
+    fprintf(f, "\n");
+    int n = Recorded();
+    for (int i = 0; i < n; i++) {
+        long long frame = frames - n + i;
+        int slot = (int)(frame % HISTORY);
+        fprintf(f, "%lld,%.3f", frame, frameMs[slot]);
+        for (int z = 0; z < zoneCount; z++) fprintf(f, ",%.3f", zoneMs[z][slot]);
+        fprintf(f, "\n");
+    }
+    return fclose(f) == 0;
+}
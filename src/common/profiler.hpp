@@ -0,0 +1,68 @@
+#pragma once
+#include "raylib.h"
+#include "alloctracker.hpp"
+#include <chrono>
+#include <cstdint>
+
+// Frame-time profiler. Zones are named timers; a ProfileScope adds the time
+// it was alive to its zone for the current frame, and EndFrame() closes the
+// frame. The last HISTORY frames are kept in fixed rings, so recording never
+// allocates. Main thread only.
+class FrameProfiler {
+    public:
+        static const int HISTORY = 256;   // frames kept
+        static const int MAX_ZONES = 16;
+
+    private:
+        const char* zoneNames[MAX_ZONES]; // not copied; pass string literals
+        int zoneCount;
+        uint64_t current[MAX_ZONES];      // ns spent in each zone this frame
+        float zoneMs[MAX_ZONES][HISTORY];
+        float frameMs[HISTORY];           // whole frame, start to start
+        long long frames;                 // frames recorded in total
+        uint64_t frameStart;
+        bool visible;
+
+        int Recorded() const {return frames < HISTORY ? (int)frames : HISTORY;}
+
+    public:
+        FrameProfiler();
+        static uint64_t Now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+        // Id for a zone name, registering it on first use; -1 once full.
+        int Zone(const char* name);
+        void Add(int zone, uint64_t ns) {if (zone >= 0) current[zone] += ns;}
+        int ZoneCount() const {return zoneCount;}
+        const char* ZoneName(int zone) const {return zoneNames[zone];}
+        // Ends the frame begun by the previous call and starts the next.
+        void EndFrame();
+
+        // Frame time in ms at percentile p (0..100) over the kept frames.
+        float Percentile(float p) const;
+        void Toggle() {visible = !visible;}
+        bool Visible() const {return visible;}
+        // Graph, percentiles and per-zone averages, top-left corner at x, y.
+        void Draw(int x, int y) const;
+        // One row per kept frame, oldest first: frame, total and every zone in ms.
+        bool ExportCsv(const char* fileName) const;
+};
+
+FrameProfiler& Profiler();
+
+// Times its own lifetime into a zone, and tags the thread's heap
+// allocations meanwhile with it (see alloctracker.hpp).
+class ProfileScope {
+    private:
+        int zone;
+        int outerAllocZone;
+        uint64_t start;
+
+    public:
+        explicit ProfileScope(int zone) : zone(zone), outerAllocZone(SetAllocZone(zone)), start(FrameProfiler::Now()) {}
+        ~ProfileScope() {
+            Profiler().Add(zone, FrameProfiler::Now() - start);
+            SetAllocZone(outerAllocZone);
+        }
+};
@@ -0,0 +1,100 @@
+#include "registry.hpp"
+#include <dlfcn.h>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+static std::string Trim(const std::string& s) {
+    size_t begin = s.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    size_t end = s.find_last_not_of(" \t\r");
+    return s.substr(begin, end - begin + 1);
+}
+
+bool GameRegistry::Load(const char* manifest) {
+    std::ifstream in(manifest);
+    if (!in) {
+        error = std::string("cannot read ") + manifest;
+        return false;
+    }
+    entries.clear();
+    std::string line;
+    while (std::getline(in, line)) {
+        line = Trim(line);
+        if (line.empty() || line[0] == '#') continue;
+        size_t bar1 = line.find('|');
+        size_t bar2 = bar1 == std::string::npos ? bar1 : line.find('|', bar1 + 1);
+        if (bar1 == std::string::npos) continue;
+        Entry e;
+        e.name = Trim(line.substr(0, bar1));
+        e.library = Trim(line.substr(bar1 + 1, bar2 == std::string::npos ? std::string::npos : bar2 - bar1 - 1));
+        if (bar2 != std::string::npos) {
+            std::istringstream options(line.substr(bar2 + 1));
+            std::string option;
+            while (options >> option) e.options.push_back(option);
+        }
+        e.handle = nullptr;
+        e.module = nullptr;
+        if (!e.name.empty() && !e.library.empty()) entries.push_back(e);
+    }
+    return true;
+}
+
+const GameModule* GameRegistry::Get(int i) {
+    Entry& e = entries[i];
+    if (e.module) return e.module;
+    if (!e.handle) {
+        e.handle = dlopen(e.library.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!e.handle) {
+            const char* why = dlerror();
+            error = why ? why : "cannot load " + e.library;
+            return nullptr;
+        }
+    }
+    ArcadeModuleEntry entry = (ArcadeModuleEntry)dlsym(e.handle, ARCADE_MODULE_ENTRY);
+    if (!entry) {
+        error = e.library + " has no " ARCADE_MODULE_ENTRY;
+        return nullptr;
+    }
+    e.module = entry();
+    return e.module;
+}
+
+int GameRegistry::FindOption(const char* arg) const {
+    for (int i = 0; i < Count(); i++)
+        for (const std::string& prefix : entries[i].options)
+            if (strncmp(arg, prefix.c_str(), prefix.size()) == 0) return i;
+    return -1;
+}
+
+int GameRegistry::Command(int i, int argc, char** argv, int* at) {
+    const GameModule* module = Get(i);
+    if (!module || !module->command) return -1;
+    int from = *at;
+    int exitCode = module->command(argc, argv, at);
+    std::string& given = entries[i].given;
+    for (int k = from; k <= *at && k < argc; k++) {
+        if (!given.empty()) given += ' ';
+        given += argv[k];
+    }
+    return exitCode;
+}
+
+bool GameRegistry::ApplyOptions(int i, const std::string& options) {
+    Entry& e = entries[i];
+    if (options == e.given) return true;
+    if (!e.given.empty()) {
+        error = e.name + " was recorded with " + (options.empty() ? "no options" : "\"" + options + "\"")
+                + ", not \"" + e.given + "\"";
+        return false;
+    }
+    std::istringstream in(options);
+    std::vector<std::string> words;
+    std::string word;
+    while (in >> word) words.push_back(word);
+    std::vector<char*> argv;
+    for (std::string& w : words) argv.push_back(&w[0]);
+    argv.push_back(nullptr);
+    for (int at = 0; at < (int)words.size(); at++) Command(i, (int)words.size(), argv.data(), &at);
+    return true;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "../gamemodule.hpp"
+#include <string>
+#include <vector>
+
+// The games the launcher offers, read from a manifest with one game per line:
+//     Menu name | plugin library | command line prefixes it handles
+// Only the manifest is read at startup; a plugin is loaded the first time
+// its game is picked or one of its options is used, and stays loaded.
+class GameRegistry {
+    private:
+        struct Entry {
+            std::string name;
+            std::string library;
+            std::vector<std::string> options;
+            std::string given;      // options passed to its command hook
+            void* handle;
+            const GameModule* module;
+        };
+
+        std::vector<Entry> entries;
+        std::string error;
+
+    public:
+        // False if the manifest could not be read.
+        bool Load(const char* manifest);
+        int Count() const {return (int)entries.size();}
+        const std::string& Name(int i) const {return entries[i].name;}
+        bool Loaded(int i) const {return entries[i].module != nullptr;}
+        // Loads the game on first use; nullptr when that fails, see Error().
+        const GameModule* Get(int i);
+        // Game that handles the option arg, or -1.
+        int FindOption(const char* arg) const;
+        // Hands argv[*at] to game i's command hook, which moves *at past any
+        // values it takes, and keeps what it took for Options(). Returns the
+        // hook's exit code, or -1 when the game has no hook.
+        int Command(int i, int argc, char** argv, int* at);
+        // The options game i has been given, space-separated. Session tapes
+        // keep them, so a replay runs with the options it was recorded with.
+        const std::string& Options(int i) const {return entries[i].given;}
+        // Gives game i the options from a tape, as Command() would have.
+        // False, with Error() set, when they differ from options already
+        // given on the command line.
+        bool ApplyOptions(int i, const std::string& options);
+        const std::string& Error() const {return error;}
+};
@@ -0,0 +1,231 @@
+#include "session.hpp"
+#include <cstdio>
+#include <cstring>
+
+GameSession& Session() {
+    static GameSession session;
+    return session;
+}
+
+// Longer than any command line; a tape claiming more is corrupt
+static const uint32_t MAX_OPTIONS_SIZE = 1 << 16;
+
+static void PutVarint(std::vector<unsigned char>& out, uint32_t v) {
+    while (v >= 0x80) { out.push_back((unsigned char)(v | 0x80)); v >>= 7; }
+    out.push_back((unsigned char)v);
+}
+
+static bool GetVarint(const std::vector<unsigned char>& in, size_t& at, uint32_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 35 && at < in.size(); shift += 7) {
+        unsigned char b = in[at++];
+        v |= (uint32_t)(b & 0x7f) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static void PutFloat(std::vector<unsigned char>& out, float f) {
+    unsigned char bytes[sizeof(f)];
+    memcpy(bytes, &f, sizeof(f));
+    out.insert(out.end(), bytes, bytes + sizeof(f));
+}
+
+static bool GetFloat(const std::vector<unsigned char>& in, size_t& at, float& f) {
+    if (in.size() - at < sizeof(f)) return false;
+    memcpy(&f, &in[at], sizeof(f));
+    at += sizeof(f);
+    return true;
+}
+
+GameSession::GameSession() : mode(LIVE), readAt(0) {
+    Reset("", 1);
+}
+
+void GameSession::Reset(const char* game, uint64_t seed) {
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SESSION_MAGIC, sizeof(SESSION_MAGIC));
+    header.version = SESSION_VERSION;
+    snprintf(header.game, sizeof(header.game), "%s", game);
+    options.clear();
+    tape.clear();
+    readAt = 0;
+    error.clear();
+    tick = 0;
+    time = 0;
+    frameTime = 0;
+    memset(keyDown, 0, sizeof(keyDown));
+    memset(keyWasDown, 0, sizeof(keyWasDown));
+    mouse = {0, 0};
+    buttons = buttonsWere = 0;
+    memset(keyLatched, 0, sizeof(keyLatched));
+    buttonsLatched = 0;
+    SeedRandom(seed);
+    header.seed = seed;
+}
+
+void GameSession::SeedRandom(uint64_t seed) {
+    // the game's name picks its stream, so games never share one
+    uint64_t h = 1469598103934665603ULL; // FNV-1a
+    for (const char* c = header.game; *c; c++) h = (h ^ (unsigned char)*c) * 1099511628211ULL;
+    // splitmix64, so nearby seeds give unrelated streams
+    uint64_t z = seed ^ h;
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    rng = (z ^ (z >> 31)) | 1;
+}
+
+int GameSession::Random(int min, int max) {
+    if (min > max) { int t = min; min = max; max = t; }
+    rng ^= rng >> 12; rng ^= rng << 25; rng ^= rng >> 27;
+    uint64_t r = rng * 2685821657736338717ULL;
+    return min + (int)((r >> 32) % ((uint64_t)max - min + 1));
+}
+
+void GameSession::Begin(const char* game, uint64_t seed, bool record, const std::string& options) {
+    Reset(game, seed);
+    this->options = options;
+    header.screenWidth = GetScreenWidth();
+    header.screenHeight = GetScreenHeight();
+    mode = record ? RECORDING : LIVE;
+}
+
+bool GameSession::BeginReplay(const char* fileName) {
+    FILE* f = fopen(fileName, "rb");
+    if (!f) {
+        error = std::string("cannot read ") + fileName;
+        return false;
+    }
+    SessionHeader h;
+    bool ok = fread(&h, sizeof(h), 1, f) == 1 && memcmp(h.magic, SESSION_MAGIC, sizeof(SESSION_MAGIC)) == 0
+              && h.version == SESSION_VERSION && memchr(h.game, 0, sizeof(h.game)) != nullptr
+              && h.optionsSize <= MAX_OPTIONS_SIZE;
+    std::string opts(ok ? h.optionsSize : 0, '\0');
+    ok = ok && fread(&opts[0], 1, opts.size(), f) == opts.size();
+    std::vector<unsigned char> body;
+    if (ok) {
+        unsigned char chunk[4096];
+        size_t n;
+        while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) body.insert(body.end(), chunk, chunk + n);
+    }
+    fclose(f);
+    if (!ok) {
+        error = std::string(fileName) + " is not a version " + std::to_string(SESSION_VERSION) + " session tape";
+        return false;
+    }
+    Reset(h.game, h.seed);
+    header = h;
+    options.swap(opts);
+    tape.swap(body);
+    mode = REPLAY;
+    return true;
+}
+
+void GameSession::End() {
+    mode = LIVE;
+}
+
+bool GameSession::Save(const char* fileName, uint64_t drawHash) {
+    FILE* f = fopen(fileName, "wb");
+    if (!f) return false;
+    SessionHeader h = header;
+    h.drawHash = drawHash;
+    h.optionsSize = (uint32_t)options.size();
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1 && fwrite(options.data(), 1, options.size(), f) == options.size()
+              && fwrite(tape.data(), 1, tape.size(), f) == tape.size();
+    return fclose(f) == 0 && ok;
+}
+
+void GameSession::Latch() {
+    if (mode == REPLAY) return;
+    for (int k = 0; k < MAX_KEYS; k++) keyLatched[k] = keyLatched[k] || IsKeyDown(k) || IsKeyPressed(k);
+    for (int b = 0; b < MAX_BUTTONS; b++)
+        if (IsMouseButtonDown(b) || IsMouseButtonPressed(b)) buttonsLatched |= (uint8_t)(1 << b);
+}
+
+void GameSession::PollLive(float& dt, bool* down, Vector2& mousePos, uint8_t& held) {
+    dt = GetFrameTime();
+    for (int k = 0; k < MAX_KEYS; k++) down[k] = keyLatched[k] || IsKeyDown(k) || IsKeyPressed(k);
+    mousePos = GetMousePosition();
+    held = buttonsLatched;
+    for (int b = 0; b < MAX_BUTTONS; b++)
+        if (IsMouseButtonDown(b) || IsMouseButtonPressed(b)) held |= (uint8_t)(1 << b);
+    memset(keyLatched, 0, sizeof(keyLatched));
+    buttonsLatched = 0;
+}
+
+void GameSession::Append(float dt, const bool* down, Vector2 mousePos, uint8_t held) {
+    uint32_t flipped = 0;
+    for (int k = 0; k < MAX_KEYS; k++) flipped += down[k] != keyDown[k];
+    uint8_t flags = 0;
+    if (memcmp(&dt, &frameTime, sizeof(dt)) != 0) flags |= TICK_DT;
+    if (flipped) flags |= TICK_KEYS;
+    if (mousePos.x != mouse.x || mousePos.y != mouse.y) flags |= TICK_MOUSE;
+    if (held != buttons) flags |= TICK_BUTTONS;
+    tape.push_back(flags);
+    if (flags & TICK_DT) PutFloat(tape, dt);
+    if (flags & TICK_KEYS) {
+        PutVarint(tape, flipped);
+        for (int k = 0; k < MAX_KEYS; k++)
+            if (down[k] != keyDown[k]) PutVarint(tape, (uint32_t)k);
+    }
+    if (flags & TICK_MOUSE) { PutFloat(tape, mousePos.x); PutFloat(tape, mousePos.y); }
+    if (flags & TICK_BUTTONS) tape.push_back(held);
+}
+
+bool GameSession::ReadTick(float& dt, bool* down, Vector2& mousePos, uint8_t& held) {
+    if (tick >= (long long)header.ticks) return false;
+    if (readAt >= tape.size()) {
+        error = "session tape ends at tick " + std::to_string(tick) + " of " + std::to_string(header.ticks);
+        return false;
+    }
+    uint8_t flags = tape[readAt++];
+    dt = frameTime;
+    memcpy(down, keyDown, sizeof(keyDown));
+    mousePos = mouse;
+    held = buttons;
+    bool ok = true;
+    if (flags & TICK_DT) ok = ok && GetFloat(tape, readAt, dt);
+    if (ok && (flags & TICK_KEYS)) {
+        uint32_t flipped = 0;
+        ok = GetVarint(tape, readAt, flipped);
+        for (uint32_t i = 0; ok && i < flipped; i++) {
+            uint32_t k;
+            ok = GetVarint(tape, readAt, k) && k < (uint32_t)MAX_KEYS;
+            if (ok) down[k] = !down[k];
+        }
+    }
+    if (ok && (flags & TICK_MOUSE)) ok = GetFloat(tape, readAt, mousePos.x) && GetFloat(tape, readAt, mousePos.y);
+    if (ok && (flags & TICK_BUTTONS)) {
+        ok = readAt < tape.size();
+        if (ok) held = tape[readAt++];
+    }
+    if (!ok) error = "session tape is damaged at tick " + std::to_string(tick);
+    return ok;
+}
+
+bool GameSession::NextTick() {
+    float dt;
+    bool down[MAX_KEYS];
+    Vector2 mousePos;
+    uint8_t held;
+    if (mode == REPLAY) {
+        if (!ReadTick(dt, down, mousePos, held)) return false;
+    } else {
+        PollLive(dt, down, mousePos, held);
+        if (mode == RECORDING) {
+            Append(dt, down, mousePos, held);
+            header.ticks = (uint32_t)(tick + 1);
+        }
+    }
+    memcpy(keyWasDown, keyDown, sizeof(keyDown));
+    memcpy(keyDown, down, sizeof(keyDown));
+    buttonsWere = buttons;
+    buttons = held;
+    mouse = mousePos;
+    frameTime = dt;
+    time += dt;
+    tick++;
+    return true;
+}
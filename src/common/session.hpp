@@ -0,0 +1,130 @@
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Everything a game takes from outside itself, one tick (frame) at a time:
+// keys, the mouse, the clock and random numbers. Games ask Session() for
+// these rather than raylib, so a session can be recorded and played back
+// exactly:
+//  - live, the host's raylib supplies input and frame times as before;
+//  - recording, as live, and every tick is also appended to a tape;
+//  - replay, everything comes from a tape and real input is ignored.
+// Time() is the sum of the frame times handed out since Begin(), so it
+// is the same on replay. Random() draws from the game's own stream, seeded
+// from the session seed and the game's name. Main thread only.
+//
+// Tape file: a SessionHeader, the game's command line options (optionsSize
+// bytes, space-separated, as GameRegistry::Options() gives them), then one
+// record per tick. A record is a flags byte, followed by whichever of these
+// it flags, in this order:
+//  - TICK_DT: frame time, float32;
+//  - TICK_KEYS: count, then that many key codes, varints, whose up/down
+//    state flipped;
+//  - TICK_MOUSE: position, two float32;
+//  - TICK_BUTTONS: mouse buttons held, one bit each.
+// A tick where nothing changed is one byte.
+
+static const char SESSION_MAGIC[8] = {'A', 'R', 'C', 'R', 'E', 'C', 0, 0};
+static const uint32_t SESSION_VERSION = 2;
+
+struct SessionHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t ticks;
+    uint64_t seed;
+    int32_t screenWidth, screenHeight;
+    uint64_t drawHash;          // headless draw calls at the end, 0 if not known
+    char game[64];              // GameModule::name
+    uint32_t optionsSize;       // bytes of game options after the header
+};
+
+class GameSession {
+    public:
+        enum Mode {LIVE, RECORDING, REPLAY};
+        static const int MAX_KEYS = 512;
+        static const int MAX_BUTTONS = MOUSE_BUTTON_BACK + 1;
+
+    private:
+        enum TickFlags : uint8_t {TICK_DT = 1, TICK_KEYS = 2, TICK_MOUSE = 4, TICK_BUTTONS = 8};
+
+        Mode mode;
+        SessionHeader header;
+        std::string options;        // the game's options, for the tape
+        std::vector<unsigned char> tape;
+        size_t readAt;              // replay: next record
+        long long tick;             // ticks run since Begin()
+        double time;
+        float frameTime;
+        uint64_t rng;
+        bool keyDown[MAX_KEYS];
+        bool keyWasDown[MAX_KEYS];
+        Vector2 mouse;
+        uint8_t buttons;
+        uint8_t buttonsWere;
+        bool keyLatched[MAX_KEYS];  // held at a Latch() since the last tick
+        uint8_t buttonsLatched;
+        std::string error;
+
+        void Reset(const char* game, uint64_t seed);
+        void PollLive(float& dt, bool* down, Vector2& mousePos, uint8_t& held);
+        void Append(float dt, const bool* down, Vector2 mousePos, uint8_t held);
+        bool ReadTick(float& dt, bool* down, Vector2& mousePos, uint8_t& held);
+
+    public:
+        GameSession();
+
+        // A live session of game, recorded if record is set. options are
+        // the game's command line options; the tape keeps them so a replay
+        // can set them again.
+        void Begin(const char* game, uint64_t seed, bool record, const std::string& options = "");
+        // A replay of the tape in fileName; Game(), Seed() and the screen
+        // size say what to start. False if it cannot be read, see Error().
+        bool BeginReplay(const char* fileName);
+        // Back to live and unrecorded. What was recorded can still be saved
+        // until the next Begin().
+        void End();
+        // Writes what has been recorded so far. drawHash goes in the header.
+        bool Save(const char* fileName, uint64_t drawHash = 0);
+
+        // Starts the next tick: reads raylib, or the tape on replay. False
+        // once a replay has run out of ticks.
+        bool NextTick();
+        // Notes the keys and buttons held now, for a host that polls input
+        // more than once a tick: a press released before NextTick() polls
+        // still counts as down for that tick.
+        void Latch();
+
+        Mode GetMode() const {return mode;}
+        const char* Game() const {return header.game;}
+        const std::string& Options() const {return options;}
+        uint64_t Seed() const {return header.seed;}
+        int ScreenWidth() const {return header.screenWidth;}
+        int ScreenHeight() const {return header.screenHeight;}
+        uint64_t DrawHash() const {return header.drawHash;}
+        long long Tick() const {return tick;}
+        long long Ticks() const {return header.ticks;}   // recorded, or on the tape
+        size_t TapeBytes() const {return tape.size();}
+        const std::string& Error() const {return error;}
+
+        // As raylib's, for this tick. A key down and up again within one
+        // frame counts as down for that frame.
+        bool KeyDown(int key) const {return key >= 0 && key < MAX_KEYS && keyDown[key];}
+        bool KeyUp(int key) const {return !KeyDown(key);}
+        bool KeyPressed(int key) const {return KeyDown(key) && !keyWasDown[key];}
+        bool KeyReleased(int key) const {return key >= 0 && key < MAX_KEYS && !keyDown[key] && keyWasDown[key];}
+        bool MouseButtonDown(int button) const {return button >= 0 && button < MAX_BUTTONS && (buttons >> button & 1);}
+        bool MouseButtonPressed(int button) const {return MouseButtonDown(button) && !(buttonsWere >> button & 1);}
+        Vector2 MousePosition() const {return mouse;}
+        double Time() const {return time;}
+        float FrameTime() const {return frameTime;}
+
+        // In [min, max], like GetRandomValue.
+        int Random(int min, int max);
+        // Restarts the game's stream, for benchmarks and tools that set
+        // their own seed.
+        void SeedRandom(uint64_t seed);
+};
+
+GameSession& Session();
@@ -0,0 +1,59 @@
+#include "simthread.hpp"
+#include "session.hpp"
+#include "raylib.h"
+#include <chrono>
+
+static bool inlineMode = false;
+
+void SimThread::SetInline(bool on) {
+    inlineMode = on;
+}
+
+double SimThread::Now() {
+    return inlineMode ? Session().Time() : GetTime();
+}
+
+void SimThread::Start(double seconds, void (*fn)()) {
+    Stop();
+    step = fn;
+    stepSeconds = seconds;
+    startTime = Now();
+    ticks = 0;
+    running = true;
+    if (inlineMode) return;
+    quit.store(false);
+    thread = std::thread(&SimThread::Loop, this);
+}
+
+void SimThread::Stop() {
+    if (!running) return;
+    running = false;
+    if (!thread.joinable()) return;
+    quit.store(true);
+    thread.join();
+}
+
+void SimThread::Loop() {
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(stepSeconds));
+    const Clock::duration maxLag = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(MAX_LAG));
+    Clock::time_point next = Clock::now();
+    while (!quit.load()) {
+        step();
+        next += period;
+        Clock::time_point now = Clock::now();
+        if (now - next > maxLag) next = now;
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void SimThread::Pump() {
+    if (!running || !inlineMode) return;
+    long long due = (long long)((Now() - startTime) / stepSeconds);
+    long long maxSteps = (long long)(MAX_LAG / stepSeconds);
+    if (due - ticks > maxSteps) {
+        startTime += (due - ticks - maxSteps) * stepSeconds;
+        due = ticks + maxSteps;
+    }
+    for (; ticks < due; ticks++) step();
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <thread>
+#include <atomic>
+
+// Calls a step function at a fixed rate on its own thread, so a game's
+// simulation keeps its timing whatever the display runs at. The step may
+// call Now() but nothing from raylib or Session(); between Start() and Stop()
+// it owns the state it touches, and the main thread reads results from
+// snapshots (triplebuffer.hpp) and hands input over in atomics. A step
+// that falls more than MAX_LAG behind drops the missed time and runs in
+// slow motion rather than piling up steps.
+//
+// ArcadeHeadless, and the launcher while it records or replays a session,
+// put every SimThread in inline mode: no thread is started and Pump(), a
+// no-op otherwise, runs the steps due by the session clock on the caller,
+// so those runs stay deterministic.
+class SimThread {
+    public:
+        static constexpr double MAX_LAG = 0.25;
+
+    private:
+        std::thread thread;
+        std::atomic<bool> quit;
+        void (*step)();
+        double stepSeconds;
+        double startTime;   // inline mode: Now() at Start()
+        long long ticks;    // inline mode: steps run since Start()
+        bool running;
+
+        void Loop();
+
+    public:
+        SimThread() : quit(false), step(nullptr), stepSeconds(0), startTime(0), ticks(0), running(false) {};
+        ~SimThread() {Stop();}
+        static void SetInline(bool on);
+        // The clock steps and their readers share: the session's in inline
+        // mode, raylib's otherwise.
+        static double Now();
+
+        void Start(double stepSeconds, void (*step)());
+        // Returns once the last step has finished.
+        void Stop();
+        void Pump();
+        bool Running() const {return running;}
+};
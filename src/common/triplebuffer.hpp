@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+
+// Hands snapshots from one writer thread to one reader thread without
+// locks or waiting. The writer fills Back() and publishes it; the reader
+// picks up the newest published snapshot and keeps it until it asks again.
+// Snapshots published in between are skipped, never torn.
+template <typename T>
+class TripleBuffer {
+    private:
+        static const int FRESH = 4;     // set on middle when it has not been read
+
+        T slots[3];
+        std::atomic<int> middle;        // slot index, plus FRESH
+        int back;                       // writer's
+        int front;                      // reader's
+
+    public:
+        TripleBuffer() : middle(1), back(0), front(2) {};
+        // Every slot set to value, nothing fresh. Not safe while either side runs.
+        void Reset(const T& value) {
+            slots[0] = slots[1] = slots[2] = value;
+            middle.store(1);
+            back = 0;
+            front = 2;
+        }
+
+        // Writer side
+        T& Back() {return slots[back];}
+        void Publish() {back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & ~FRESH;}
+
+        // Reader side. True if a newer snapshot was picked up.
+        bool Acquire() {
+            if (!(middle.load(std::memory_order_acquire) & FRESH)) return false;
+            front = middle.exchange(front, std::memory_order_acq_rel) & ~FRESH;
+            return true;
+        }
+        const T& Front() const {return slots[front];}
+};
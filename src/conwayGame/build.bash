@@ -5,7 +5,7 @@ set -e
 for src in *.cpp; do
   obj="${src%.cpp}.o"
   echo "➜ Compiling $src → $obj"
-  g++ -c "$src" -o "$obj" \
+  g++ -c "$src" -o "$obj" -fPIC \
       -I.             # so #include "header.h" works if you have headers
 done
 
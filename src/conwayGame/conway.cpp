@@ -1,5 +1,7 @@
 #include "conway.hpp"
 #include "simulation.hpp" // your existing Simulation class
+#include "../common/bench.hpp"
+#include "../common/session.hpp"
 #include <string>
 
 // Colors
@@ -12,76 +14,91 @@ namespace {
 
     int windowWidth = 0;
     int windowHeight = 0;
-    int fps = 12;
+    int generationRate = 12;        // per second; its own clock, not the frame rate
+    double lastGeneration = 0;
     int cellSize = 15;
 
     Simulation* sim = nullptr;
+    int simCellSize = 0;            // cell size sim was built for
+}
+
+// An empty, stopped board at the current cell size. The old one is kept when
+// the size has not changed, so going back to the menu or starting a new run
+// allocates nothing.
+static void ResetSimulation() {
+    if (sim && simCellSize == cellSize) {
+        sim->Stop();
+        sim->ClearGrid();
+        return;
+    }
+    delete sim;
+    sim = new Simulation(windowWidth, windowHeight, cellSize);
+    simCellSize = cellSize;
 }
 
 bool InitConway() {
     // Setup window dims to match main launcher
     windowWidth = GetScreenWidth();
     windowHeight = GetScreenHeight();
-    fps = 12;
+    generationRate = 12;
     cellSize = 15;
 
     // Initialize simulation
-    sim = new Simulation(windowWidth, windowHeight, cellSize);
+    ResetSimulation();
     state = CState::Menu;
-    SetTargetFPS(fps);
     SetWindowTitle("Conway's Game of Life");
     return true;
 }
 
 void UpdateConway() {
     // Return to menu if BACKSPACE
-    if (IsKeyPressed(KEY_BACKSPACE)) {
+    if (Session().KeyPressed(KEY_BACKSPACE)) {
         state = CState::Menu;
-        delete sim;
-        sim = new Simulation(windowWidth, windowHeight, cellSize);
+        ResetSimulation();
         SetWindowTitle("Conway's Game of Life");
         return;
     }
 
     if (state == CState::Menu) {
-        if (IsKeyPressed(KEY_RIGHT) && cellSize < 50) cellSize++;
-        if (IsKeyPressed(KEY_LEFT) && cellSize > 1)  cellSize--;
-        if (IsKeyPressed(KEY_ENTER)) {
-            delete sim;
-            sim = new Simulation(windowWidth, windowHeight, cellSize);
+        if (Session().KeyPressed(KEY_RIGHT) && cellSize < 50) cellSize++;
+        if (Session().KeyPressed(KEY_LEFT) && cellSize > 1)  cellSize--;
+        if (Session().KeyPressed(KEY_ENTER)) {
+            ResetSimulation();
             state = CState::Running;
             SetWindowTitle("Running Game of Life...");
         }
     } else {
         // Running state controls
-        if (IsKeyPressed(KEY_SPACE)) {
+        if (Session().KeyPressed(KEY_SPACE)) {
             sim->Stop();
             SetWindowTitle("Stopped Game of Life...");
-        } else if (IsKeyPressed(KEY_ENTER)) {
+        } else if (Session().KeyPressed(KEY_ENTER)) {
             sim->Start();
             SetWindowTitle("Running Game of Life...");
-        } else if (IsKeyPressed(KEY_UP) && fps < 60) {
-            fps += 2; SetTargetFPS(fps);
-        } else if (IsKeyPressed(KEY_DOWN) && fps > 5) {
-            fps -= 2; SetTargetFPS(fps);
-        } else if (IsKeyPressed(KEY_R)) {
+        } else if (Session().KeyPressed(KEY_UP) && generationRate < 60) {
+            generationRate += 2;
+        } else if (Session().KeyPressed(KEY_DOWN) && generationRate > 5) {
+            generationRate -= 2;
+        } else if (Session().KeyPressed(KEY_R)) {
             sim->CreateRandomState();
-        } else if (IsKeyPressed(KEY_C)) {
+        } else if (Session().KeyPressed(KEY_C)) {
             sim->ClearGrid();
         }
         // Mouse toggle
-        if (IsMouseButtonDown(MOUSE_BUTTON_LEFT)) {
-            Vector2 mp = GetMousePosition();
+        if (Session().MouseButtonDown(MOUSE_BUTTON_LEFT)) {
+            Vector2 mp = Session().MousePosition();
             int row = mp.y / cellSize;
             int col = mp.x / cellSize;
             sim->ToggleCell(row, col);
         }
-        sim->Update();
+        if (Session().Time() - lastGeneration >= 1.0 / generationRate) {
+            lastGeneration = Session().Time();
+            sim->Update();
+        }
     }
 }
 
 void DrawConway() {
-    BeginDrawing();
     ClearBackground(INDIGO);
 
     if (state == CState::Menu) {
@@ -99,11 +116,25 @@ void DrawConway() {
     } else {
         sim->Draw();
     }
-
-    EndDrawing();
 }
 
 void UnloadConway() {
     delete sim;
     sim = nullptr;
 }
+
+// --- Benchmarks ---
+// One generation over the screen at the game's own cell sizes, from the
+// default down to the smallest; starts from a random soup like R does.
+void AddConwayBenchmarks(BenchSuite& suite) {
+    static Simulation* bench = nullptr;
+    suite.Add({"conway/update", "px per cell", {15, 5, 1},
+        [](int size, uint64_t seed) {
+            Session().SeedRandom(seed);
+            bench = new Simulation(GetScreenWidth(), GetScreenHeight(), size);
+            bench->CreateRandomState();
+            bench->Start();
+        },
+        [] { bench->Update(); },
+        [] { delete bench; bench = nullptr; }});
+}
@@ -1,7 +1,11 @@
 #pragma once
 #include "raylib.h"
 
+class BenchSuite;
+
 bool InitConway();
 void UpdateConway();
 void DrawConway();
-void UnloadConway();
\ No newline at end of file
+void UnloadConway();
+// Adds Simulation::Update on growing grids to ArcadeBench.
+void AddConwayBenchmarks(BenchSuite& suite);
\ No newline at end of file
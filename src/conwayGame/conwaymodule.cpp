@@ -0,0 +1,7 @@
+#include "conway.hpp"
+#include "../gamemodule.hpp"
+
+extern "C" const GameModule* ArcadeGetModule() {
+    static const GameModule module = {"Conway's Game of Life", InitConway, UpdateConway, DrawConway, UnloadConway, nullptr, nullptr, AddConwayBenchmarks};
+    return &module;
+}
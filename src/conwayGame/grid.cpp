@@ -1,4 +1,5 @@
 #include "grid.hpp"
+#include "../common/session.hpp"
 #include <raylib.h>
 
 Color navy = {35, 15, 92, 255};
@@ -36,7 +37,7 @@ bool Grid::IsInBounds(int row, int col) {
 void Grid::FillRandom() {
     for (int row=0; row<rows; row++) {
         for (int col=0; col < cols; col++) {
-            int randomValue = GetRandomValue(0, 4);
+            int randomValue = Session().Random(0, 4);
             cells[row][col] = (randomValue == 4) ? 1 : 0;
         }
     }
@@ -1,5 +1,5 @@
 #include "simulation.hpp"
-#include <vector>
+#include "../common/jobs.hpp"
 #include <utility>
 
 
@@ -13,7 +13,7 @@ void Simulation::SetCellValue(int row, int col, int val) {
 
 int Simulation::CountLiveNeighs(int row, int col) {
     int liveNeighs = 0;
-    std::vector<std::pair<int, int>> neighborOffsets = 
+    static const std::pair<int, int> neighborOffsets[] =
     {
         {-1,0}, {1,0}, {0,-1}, {0,1}, {-1,-1}, {-1,1}, {1,-1}, {1,1}
     };
@@ -28,25 +28,29 @@ int Simulation::CountLiveNeighs(int row, int col) {
 
 void Simulation::Update() {
     if (IsRunning()) {
-        for (int row=0; row<grid.GetRows(); row++) {
-            for (int col=0; col < grid.GetCols(); col++) {
-                int liveNeighs = CountLiveNeighs(row, col);
-                int cellValue = grid.GetValue(row, col);
-                if (cellValue == 1) {
-                    if (liveNeighs > 3 || liveNeighs < 2) {
-                        tempGrid.SetValue(row, col, 0);
+        // each row only writes its own row of tempGrid, so rows split across workers
+        auto step = [this](int begin, int end, int) {
+            for (int row=begin; row<end; row++) {
+                for (int col=0; col < grid.GetCols(); col++) {
+                    int liveNeighs = CountLiveNeighs(row, col);
+                    int cellValue = grid.GetValue(row, col);
+                    if (cellValue == 1) {
+                        if (liveNeighs > 3 || liveNeighs < 2) {
+                            tempGrid.SetValue(row, col, 0);
+                        } else {
+                            tempGrid.SetValue(row, col, 1);
+                        }
                     } else {
-                        tempGrid.SetValue(row, col, 1);
-                    }
-                } else {
-                    if (liveNeighs == 3) {
-                        tempGrid.SetValue(row, col, 1);
-                    } else {
-                        tempGrid.SetValue(row, col, 0);
+                        if (liveNeighs == 3) {
+                            tempGrid.SetValue(row, col, 1);
+                        } else {
+                            tempGrid.SetValue(row, col, 0);
+                        }
                     }
                 }
             }
-        }
+        };
+        Jobs().ParallelFor(grid.GetRows(), 16, step);
         grid = tempGrid;
     }
 }
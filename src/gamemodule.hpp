@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdlib>
+
+class BenchSuite;
+
+// What each game plugin hands the launcher. Every game builds as a shared
+// library exporting ArcadeGetModule(), and the launcher dlopens it the first
+// time the game is picked. Raylib and the code in src/common come from the
+// host executable: the launcher, so every game draws to the same window, or
+// ArcadeHeadless (src/headless), which runs games without one.
+struct GameModule {
+    const char* name;
+    bool (*init)();     // false sends the launcher back to the menu
+    void (*update)();
+    void (*draw)();
+    void (*unload)();
+    // Optional; games without it keep running in the background. Called
+    // with true when the window loses focus and with false when it comes
+    // back. Return false to keep getting updates meanwhile, e.g. during
+    // online play; otherwise update is skipped until resumed.
+    bool (*suspend)(bool suspended);
+    // Optional. Handles the command line option at argv[*i], moving *i past
+    // any values it takes. Returns an exit code to quit with after a
+    // headless run, or -1 to carry on to the menu.
+    int (*command)(int argc, char** argv, int* i);
+    // Optional. Adds the game's hot paths to ArcadeBench (src/common/bench.hpp).
+    void (*benchmarks)(BenchSuite& suite);
+};
+
+// For command hooks: the count after argv[*i], or fallback when it is missing
+// or not positive. *i only moves past a number, so an option that follows
+// is left for the next hook.
+inline int OptionalCount(int argc, char** argv, int* i, int fallback) {
+    if (*i + 1 >= argc) return fallback;
+    char* end;
+    long value = strtol(argv[*i + 1], &end, 10);
+    if (end == argv[*i + 1] || *end) return fallback;
+    ++*i;
+    return value > 0 ? (int)value : fallback;
+}
+
+#define ARCADE_MODULE_ENTRY "ArcadeGetModule"
+extern "C" typedef const GameModule* (*ArcadeModuleEntry)();
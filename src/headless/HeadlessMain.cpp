@@ -0,0 +1,172 @@
+#include <raylib.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <strings.h>
+#include <thread>
+#include <algorithm>
+
+#include "platform.hpp"
+#include "../common/registry.hpp"
+#include "../common/simthread.hpp"
+#include "../common/jobs.hpp"
+#include "../common/assetpack.hpp"
+#include "../common/session.hpp"
+#include "../common/profiler.hpp"
+#include "../common/alloctracker.hpp"
+
+// Runs the games without a window, as fast as they go, for benchmarks and
+// soak tests. Game options (--pong-ai, --snake-board, ...) work as they do
+// for the launcher.
+//
+//   ArcadeHeadless [--game NAME|all] [--frames N] [--dt SECONDS] [--size WxH]
+//                  [--script FILE] [--monkey SEED] [--seed N] [--record FILE]
+//                  [--jobs N] [--allocs] [--strict-allocs] [game options]
+//   ArcadeHeadless --replay FILE
+//
+// Without a script the games get random key presses (--monkey 0 turns them off).
+// --record saves the one game's session as a tape (see common/session.hpp),
+// with the game's options; --replay plays a tape back, from the launcher or
+// from here, as fast as it goes, with the options it was recorded with, and
+// checks the draw calls against the recording's when it has them.
+// --jobs sets the job workers, the calling thread included, in place of one
+// per core, e.g. to check a multi-core run on a smaller machine;
+// --allocs counts heap allocations per frame, in update and draw;
+// --strict-allocs also reports each frame that allocates once a game has
+// been running for AllocTracker::WARMUP_FRAMES.
+
+static const char* GAMES_MANIFEST = "games.cfg";
+static const char* ASSET_PACK = "build/assets.pak";
+
+int main(int argc, char** argv) {
+    SimThread::SetInline(true);     // steps follow the simulated clock
+    Jobs().Start((int)std::thread::hardware_concurrency() - 1);
+    GameRegistry games;
+    if (!games.Load(GAMES_MANIFEST)) { fprintf(stderr, "%s\n", games.Error().c_str()); return 1; }
+    if (!Assets().Open(ASSET_PACK)) fprintf(stderr, "%s; games load data/ files instead\n", Assets().Error().c_str());
+
+    std::string pick = "all";
+    long long frames = 3600;
+    unsigned int seed = 1;
+    long long monkey = -1;          // -1: on unless a script is given
+    bool scripted = false;
+    const char* recordFile = nullptr;
+    const char* replayFile = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--game") == 0 && i + 1 < argc) {
+            pick = argv[++i];
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--dt") == 0 && i + 1 < argc) {
+            HeadlessSetFrameTime((float)atof(argv[++i]));
+        } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            int w = 0, h = 0;
+            if (sscanf(argv[++i], "%dx%d", &w, &h) == 2) HeadlessSetScreen(w, h);
+        } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            if (!HeadlessLoadScript(argv[++i])) { fprintf(stderr, "cannot read %s\n", argv[i]); return 1; }
+            scripted = true;
+        } else if (strcmp(argv[i], "--monkey") == 0 && i + 1 < argc) {
+            monkey = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            Jobs().Start(std::max(1, atoi(argv[++i])) - 1);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (unsigned int)atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordFile = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayFile = argv[++i];
+        } else if (strcmp(argv[i], "--allocs") == 0) {
+            Allocs().SetCounting(true);
+        } else if (strcmp(argv[i], "--strict-allocs") == 0) {
+            Allocs().SetStrict(true);
+        } else {
+            int g = games.FindOption(argv[i]);
+            if (g < 0) { fprintf(stderr, "unknown option %s\n", argv[i]); return 1; }
+            const GameModule* module = games.Get(g);
+            if (!module) { fprintf(stderr, "%s: %s\n", argv[i], games.Error().c_str()); return 1; }
+            int exitCode = games.Command(g, argc, argv, &i);
+            if (exitCode >= 0) return exitCode;
+        }
+    }
+    if (monkey < 0) monkey = scripted ? 0 : seed;
+    if (replayFile) {
+        // the tape says what to run, and supplies all the input
+        if (!Session().BeginReplay(replayFile)) { fprintf(stderr, "%s\n", Session().Error().c_str()); return 1; }
+        pick = Session().Game();
+        frames = Session().Ticks();
+        HeadlessSetScreen(Session().ScreenWidth(), Session().ScreenHeight());
+        monkey = 0;
+    }
+
+    std::vector<int> chosen;
+    for (int g = 0; g < games.Count(); g++) {
+        const std::string& name = games.Name(g);
+        if (replayFile ? name == pick : pick == "all" || strncasecmp(name.c_str(), pick.c_str(), pick.size()) == 0)
+            chosen.push_back(g);
+    }
+    if (chosen.empty()) { fprintf(stderr, "no game matches %s\n", pick.c_str()); return 1; }
+    if (recordFile && chosen.size() != 1) { fprintf(stderr, "--record needs --game with one game\n"); return 1; }
+    if (replayFile && !games.ApplyOptions(chosen[0], Session().Options())) { fprintf(stderr, "%s\n", games.Error().c_str()); return 1; }
+
+    if (replayFile) printf("%lld frames replayed from %s%s%s\n", frames, replayFile,
+                           Session().Options().empty() ? "" : ", with ", Session().Options().c_str());
+    else printf("%lld frames per game, %s input\n", frames, scripted ? (monkey ? "scripted and random" : "scripted") : monkey ? "random" : "no");
+    printf("%d job workers\n", Jobs().Size());
+    printf("%-24s %10s %10s %12s %12s %10s %8s\n", "game", "sim s", "wall ms", "frames/s", "draws/frame", "sounds", "busy %");
+    const int zoneUpdate = Profiler().Zone("update");
+    const int zoneDraw = Profiler().Zone("draw");
+    int failures = 0;
+    for (int g : chosen) {
+        const GameModule* game = games.Get(g);
+        if (!game) { printf("%-24s %s\n", games.Name(g).c_str(), games.Error().c_str()); failures++; continue; }
+        HeadlessReset();
+        HeadlessSetMonkey((uint32_t)monkey);
+        if (!replayFile) Session().Begin(game->name, seed, recordFile != nullptr, games.Options(g));
+        if (!game->init()) { printf("%-24s init failed\n", game->name); failures++; Session().End(); continue; }
+        Jobs().Sample();
+        Allocs().ResetTotals();
+        auto start = std::chrono::steady_clock::now();
+        long long stepped = 0;          // fewer than frames when a replay runs out
+        for (; stepped < frames; stepped++) {
+            HeadlessNextFrame();
+            if (!Session().NextTick()) break;
+            { ProfileScope scope(zoneUpdate); game->update(); }
+            { ProfileScope scope(zoneDraw); game->draw(); }
+            Allocs().SetSteady(true);
+            Allocs().EndFrame();
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        double simSeconds = GetTime();
+        JobStats jobs = Jobs().Sample();
+        game->unload();
+        float busy = 0;
+        for (int w = 0; w < jobs.workers; w++) busy += jobs.busy[w] / jobs.workers;
+        HeadlessStats stats = HeadlessGetStats();
+        printf("%-24s %10.1f %10.1f %12.0f %12.1f %10lld %8.0f\n", game->name, simSeconds, ms,
+               ms > 0 ? stepped / (ms / 1000.0) : 0.0, stepped ? (double)stats.drawCalls / stepped : 0.0, stats.soundsPlayed,
+               busy * 100.0f);
+        if (Allocs().Counting()) {
+            AllocCounts all = Allocs().Total(), update = Allocs().ZoneTotal(zoneUpdate), draw = Allocs().ZoneTotal(zoneDraw);
+            double per = stepped ? 1.0 / stepped : 0.0;
+            printf("%-24s %.2f allocs/frame (update %.2f, draw %.2f), %.2f frees/frame, %.0f bytes/frame\n", "",
+                   all.allocs * per, update.allocs * per, draw.allocs * per, all.frees * per, all.bytes * per);
+            if (Allocs().Strict()) printf("%-24s %lld steady-state frames allocated\n", "", Allocs().StrictFrames());
+        }
+        if (recordFile) {
+            if (!Session().Save(recordFile, stats.drawHash)) { fprintf(stderr, "cannot write %s\n", recordFile); failures++; }
+            else printf("recorded %lld ticks, %zu bytes of input, to %s\n", Session().Ticks(), Session().TapeBytes(), recordFile);
+        }
+        if (replayFile) {
+            if (!Session().Error().empty()) { printf("%s\n", Session().Error().c_str()); failures++; }
+            else if (Session().DrawHash() == 0) printf("draw hash %016llx\n", (unsigned long long)stats.drawHash);
+            else if (Session().DrawHash() == stats.drawHash) printf("replay matches the recording\n");
+            else { printf("replay DIFFERS from the recording\n"); failures++; }
+        }
+        Session().End();
+    }
+    Jobs().Stop();
+    return failures == 0 ? 0 : 1;
+}
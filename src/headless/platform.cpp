@@ -0,0 +1,316 @@
+#include "platform.hpp"
+#include "raylib.h"
+#include "rlgl.h"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdarg>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <cmath>
+
+static const int MAX_KEYS = 512;
+
+namespace {
+    struct KeyHold {
+        int key;
+        long long from;
+        long long until;    // first frame it is up again
+    };
+
+    int screenW = 1200;
+    int screenH = 800;
+    float frameTime = 1.0f / 60.0f;
+    double simTime = 0;
+    long long frame = -1;   // HeadlessNextFrame() starts frame 0
+
+    std::vector<KeyHold> script;
+    std::vector<KeyHold> monkeyHolds;
+    uint32_t monkeyRng = 0;
+    bool keyDown[MAX_KEYS];
+    bool keyWasDown[MAX_KEYS];
+
+    uint32_t randomState = 1;
+    unsigned int nextTextureId = 1;
+    HeadlessStats stats;
+
+    // Keys the random presses pick from: movement, fire and the menu keys
+    // the games share.
+    const int MONKEY_KEYS[] = {KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT, KEY_SPACE, KEY_ENTER,
+                               KEY_BACKSPACE, KEY_A, KEY_B, KEY_C, KEY_M, KEY_R};
+
+    struct KeyName {
+        const char* name;
+        int key;
+    };
+    const KeyName KEY_NAMES[] = {
+        {"SPACE", KEY_SPACE}, {"ENTER", KEY_ENTER}, {"BACKSPACE", KEY_BACKSPACE}, {"ESCAPE", KEY_ESCAPE},
+        {"TAB", KEY_TAB}, {"UP", KEY_UP}, {"DOWN", KEY_DOWN}, {"LEFT", KEY_LEFT}, {"RIGHT", KEY_RIGHT},
+    };
+
+    uint32_t XorShift(uint32_t& r) {
+        r ^= r << 13;
+        r ^= r >> 17;
+        r ^= r << 5;
+        return r;
+    }
+
+    int ParseKey(const std::string& name) {
+        if (name.size() == 1 && isalnum((unsigned char)name[0])) return toupper((unsigned char)name[0]);
+        for (const KeyName& k : KEY_NAMES)
+            if (name == k.name) return k.key;
+        if (name.size() > 1 && name[0] == 'F' && isdigit((unsigned char)name[1])) return KEY_F1 + atoi(name.c_str() + 1) - 1;
+        return atoi(name.c_str());
+    }
+
+    bool Down(int key) {return key >= 0 && key < MAX_KEYS && keyDown[key];}
+    bool WasDown(int key) {return key >= 0 && key < MAX_KEYS && keyWasDown[key];}
+
+    // Width and height from a PNG's IHDR chunk, 0x0 if it is not one.
+    void PngSize(const char* fileName, int& width, int& height) {
+        width = height = 0;
+        unsigned char h[24];
+        FILE* f = fopen(fileName, "rb");
+        if (!f) return;
+        size_t n = fread(h, 1, sizeof(h), f);
+        fclose(f);
+        if (n < sizeof(h) || memcmp(h, "\x89PNG", 4) != 0) return;
+        width = (h[16] << 24) | (h[17] << 16) | (h[18] << 8) | h[19];
+        height = (h[20] << 24) | (h[21] << 16) | (h[22] << 8) | h[23];
+    }
+
+    // FNV-1a over what every draw call was asked to draw, so two runs can
+    // be compared without pixels. Texture ids are left out, sizes go in;
+    // text is left out, as HUDs show wall-clock timings.
+    void Hash(const void* data, size_t size) {
+        const unsigned char* bytes = (const unsigned char*)data;
+        for (size_t i = 0; i < size; i++) stats.drawHash = (stats.drawHash ^ bytes[i]) * 1099511628211ULL;
+    }
+    template <typename... T>
+    void Drawn(const T&... args) {
+        stats.drawCalls++;
+        (Hash(&args, sizeof(args)), ...);
+    }
+
+    Texture2D MakeTexture(int width, int height) {
+        Texture2D t = {};
+        t.id = nextTextureId++;
+        t.width = width;
+        t.height = height;
+        t.mipmaps = 1;
+        t.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+        stats.texturesLoaded++;
+        return t;
+    }
+}
+
+// --- Runner side ---
+
+void HeadlessSetScreen(int width, int height) {screenW = width; screenH = height;}
+void HeadlessSetFrameTime(float seconds) {frameTime = seconds;}
+
+void HeadlessReset() {
+    frame = -1;
+    simTime = 0;
+    monkeyHolds.clear();
+    memset(keyDown, 0, sizeof(keyDown));
+    memset(keyWasDown, 0, sizeof(keyWasDown));
+    stats = HeadlessStats();
+    stats.drawHash = 1469598103934665603ULL;
+}
+
+void HeadlessHoldKey(int key, long long fromFrame, int frames) {
+    script.push_back({key, fromFrame, fromFrame + (frames > 0 ? frames : 1)});
+}
+
+bool HeadlessLoadScript(const char* fileName) {
+    std::ifstream in(fileName);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        long long at;
+        std::string key;
+        int frames = 1;
+        if (!(fields >> at >> key)) continue;
+        fields >> frames;
+        HeadlessHoldKey(ParseKey(key), at, frames);
+    }
+    return true;
+}
+
+void HeadlessSetMonkey(uint32_t seed) {monkeyRng = seed;}
+
+void HeadlessNextFrame() {
+    frame++;
+    if (frame > 0) simTime += frameTime;
+    memcpy(keyWasDown, keyDown, sizeof(keyDown));
+    memset(keyDown, 0, sizeof(keyDown));
+
+    // about three new presses a second, each held up to half a second
+    if (monkeyRng && XorShift(monkeyRng) % 20 == 0) {
+        int key = MONKEY_KEYS[XorShift(monkeyRng) % (sizeof(MONKEY_KEYS) / sizeof(MONKEY_KEYS[0]))];
+        monkeyHolds.push_back({key, frame, frame + 1 + XorShift(monkeyRng) % 30});
+    }
+    for (size_t i = 0; i < monkeyHolds.size();) {
+        if (monkeyHolds[i].until <= frame) { monkeyHolds[i] = monkeyHolds.back(); monkeyHolds.pop_back(); continue; }
+        if (monkeyHolds[i].key < MAX_KEYS) keyDown[monkeyHolds[i].key] = true;
+        i++;
+    }
+    for (const KeyHold& h : script)
+        if (frame >= h.from && frame < h.until && h.key >= 0 && h.key < MAX_KEYS) keyDown[h.key] = true;
+}
+
+long long HeadlessFrame() {return frame;}
+HeadlessStats HeadlessGetStats() {return stats;}
+
+// --- Window and time ---
+
+void SetTargetFPS(int) {}
+void SetWindowTitle(const char*) {}
+int GetScreenWidth(void) {return screenW;}
+int GetScreenHeight(void) {return screenH;}
+double GetTime(void) {return simTime;}
+float GetFrameTime(void) {return frameTime;}
+int GetFPS(void) {return (int)lroundf(1.0f / frameTime);}
+void PollInputEvents(void) {}
+
+// --- Input ---
+
+bool IsKeyDown(int key) {return Down(key);}
+bool IsKeyUp(int key) {return !Down(key);}
+bool IsKeyPressed(int key) {return Down(key) && !WasDown(key);}
+bool IsKeyReleased(int key) {return !Down(key) && WasDown(key);}
+bool IsMouseButtonDown(int) {return false;}
+bool IsMouseButtonPressed(int) {return false;}
+Vector2 GetMousePosition(void) {return {0, 0};}
+
+// --- Drawing: counted, not drawn ---
+
+void BeginDrawing(void) {}
+void EndDrawing(void) {}
+void ClearBackground(Color color) {Drawn(color);}
+void BeginMode2D(Camera2D) {}
+void EndMode2D(void) {}
+void BeginScissorMode(int, int, int, int) {}
+void EndScissorMode(void) {}
+void BeginTextureMode(RenderTexture2D) {}
+void EndTextureMode(void) {}
+void DrawPixel(int x, int y, Color color) {Drawn(x, y, color);}
+void DrawPixelV(Vector2 p, Color color) {Drawn(p, color);}
+void DrawLine(int x0, int y0, int x1, int y1, Color color) {Drawn(x0, y0, x1, y1, color);}
+void DrawLineV(Vector2 a, Vector2 b, Color color) {Drawn(a, b, color);}
+void DrawLineEx(Vector2 a, Vector2 b, float thick, Color color) {Drawn(a, b, thick, color);}
+void DrawCircle(int x, int y, float radius, Color color) {Drawn(x, y, radius, color);}
+void DrawCircleV(Vector2 c, float radius, Color color) {Drawn(c, radius, color);}
+void DrawCircleLines(int x, int y, float radius, Color color) {Drawn(x, y, radius, color);}
+void DrawTriangle(Vector2 a, Vector2 b, Vector2 c, Color color) {Drawn(a, b, c, color);}
+void DrawRectangle(int x, int y, int w, int h, Color color) {Drawn(x, y, w, h, color);}
+void DrawRectangleV(Vector2 p, Vector2 size, Color color) {Drawn(p, size, color);}
+void DrawRectangleRec(Rectangle r, Color color) {Drawn(r, color);}
+void DrawRectangleLines(int x, int y, int w, int h, Color color) {Drawn(x, y, w, h, color);}
+void DrawRectangleLinesEx(Rectangle r, float thick, Color color) {Drawn(r, thick, color);}
+void DrawRectangleRounded(Rectangle r, float roundness, int segments, Color color) {Drawn(r, roundness, segments, color);}
+void DrawRectangleRoundedLines(Rectangle r, float roundness, int segments, Color color) {Drawn(r, roundness, segments, color);}
+void DrawTexture(Texture2D t, int x, int y, Color tint) {Drawn(t.width, t.height, x, y, tint);}
+void DrawTextureV(Texture2D t, Vector2 p, Color tint) {Drawn(t.width, t.height, p, tint);}
+void DrawTextureRec(Texture2D t, Rectangle src, Vector2 p, Color tint) {Drawn(t.width, t.height, src, p, tint);}
+void DrawText(const char*, int x, int y, int size, Color color) {Drawn(x, y, size, color);}
+
+void rlBegin(int mode) {Drawn(mode);}
+void rlEnd(void) {}
+void rlVertex2f(float x, float y) {Hash(&x, sizeof(x)); Hash(&y, sizeof(y));}
+void rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a) {Color c = {r, g, b, a}; Hash(&c, sizeof(c));}
+
+// Roughly the default font's advance, which is all layout code asks for
+int MeasureText(const char* text, int fontSize) {
+    return text ? (int)(strlen(text) * fontSize * 0.6f) : 0;
+}
+
+const char* TextFormat(const char* text, ...) {
+    // a few rotating buffers, as raylib does, so several results can be live
+    static char buffers[4][1024];
+    static int next = 0;
+    char* buffer = buffers[next];
+    next = (next + 1) % 4;
+    va_list args;
+    va_start(args, text);
+    vsnprintf(buffer, sizeof(buffers[0]), text, args);
+    va_end(args);
+    return buffer;
+}
+
+// --- Textures and images: sizes only ---
+
+Image LoadImage(const char* fileName) {
+    Image img = {};
+    PngSize(fileName, img.width, img.height);
+    img.mipmaps = 1;
+    img.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return img;
+}
+void UnloadImage(Image) {}
+void ImageResize(Image* image, int newWidth, int newHeight) {image->width = newWidth; image->height = newHeight;}
+
+Texture2D LoadTexture(const char* fileName) {
+    int w, h;
+    PngSize(fileName, w, h);
+    return w > 0 ? MakeTexture(w, h) : Texture2D{};
+}
+Texture2D LoadTextureFromImage(Image image) {return MakeTexture(image.width, image.height);}
+void UnloadTexture(Texture2D) {}
+
+RenderTexture2D LoadRenderTexture(int width, int height) {
+    RenderTexture2D target = {};
+    target.texture = MakeTexture(width, height);
+    target.id = target.texture.id;
+    return target;
+}
+void UnloadRenderTexture(RenderTexture2D) {}
+
+// --- Audio: counted, not played ---
+
+void InitAudioDevice(void) {}
+void CloseAudioDevice(void) {}
+Wave LoadWave(const char*) {return Wave{};}
+void UnloadWave(Wave) {}
+Sound LoadSound(const char*) {return Sound{};}
+Sound LoadSoundFromWave(Wave) {return Sound{};}
+void UnloadSound(Sound) {}
+void PlaySound(Sound) {stats.soundsPlayed++;}
+void SetSoundVolume(Sound, float) {}
+
+// --- Pure helpers, same results as raylib ---
+
+void SetRandomSeed(unsigned int seed) {randomState = seed ? seed : 1;}
+
+int GetRandomValue(int min, int max) {
+    if (min > max) { int t = min; min = max; max = t; }
+    uint32_t range = (uint32_t)(max - min) + 1u;
+    uint32_t r = XorShift(randomState);
+    return range == 0 ? (int)r : min + (int)(r % range);
+}
+
+bool CheckCollisionRecs(Rectangle a, Rectangle b) {
+    return a.x < b.x + b.width && a.x + a.width > b.x && a.y < b.y + b.height && a.y + a.height > b.y;
+}
+
+Color Fade(Color color, float alpha) {
+    alpha = alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+    color.a = (unsigned char)(255.0f * alpha);
+    return color;
+}
+
+Color ColorFromHSV(float hue, float saturation, float value) {
+    // raylib's formula, one channel at a time
+    auto channel = [&](float n) {
+        float k = fmodf(n + hue / 60.0f, 6);
+        k = fmaxf(fminf(fminf(k, 4.0f - k), 1.0f), 0.0f);
+        return (unsigned char)((value - value * saturation * k) * 255.0f);
+    };
+    return {channel(5), channel(3), channel(1), 255};
+}
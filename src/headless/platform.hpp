@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+
+// Headless backend for the games. The games talk to the platform through
+// the raylib calls they already make; ArcadeGames gets those from raylib,
+// and ArcadeHeadless gets them from platform.cpp instead:
+//  - time is simulated, a fixed step per frame;
+//  - keys come from a script and/or seeded random presses;
+//  - drawing and audio calls are counted, hashed and dropped;
+//  - textures only read their size from the PNG header.
+// This header is the runner's side: it drives the frames and reads the counts.
+
+struct HeadlessStats {
+    long long drawCalls;
+    long long soundsPlayed;
+    long long texturesLoaded;
+    uint64_t drawHash;          // of every draw call's arguments, in order
+};
+
+void HeadlessSetScreen(int width, int height);
+void HeadlessSetFrameTime(float seconds);
+// Back to frame 0 and time 0 with no keys held; keeps the script.
+void HeadlessReset();
+
+// Holds key for `frames` frames from fromFrame, counted from the last reset.
+void HeadlessHoldKey(int key, long long fromFrame, int frames);
+// Lines of "frame key [frames held]"; keys by raylib name without KEY_
+// (ENTER, UP, A, ...) or by number. False if the file cannot be read.
+bool HeadlessLoadScript(const char* fileName);
+// Random presses of the common game keys from this seed; 0 turns them off.
+void HeadlessSetMonkey(uint32_t seed);
+
+// Starts the next frame: advances time and works out which keys are down.
+void HeadlessNextFrame();
+long long HeadlessFrame();
+HeadlessStats HeadlessGetStats();
@@ -0,0 +1,128 @@
+#include <raylib.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+#include "../common/assetpack.hpp"
+
+// Builds the asset pack the games load from (see src/common/assetpack.hpp).
+// Every asset in the manifest is decoded with raylib and written out as raw
+// RGBA8 pixels or 16-bit PCM, so nothing is decoded when a game starts.
+//
+//   ArcadePack [MANIFEST [PACK]]      defaults: assets.cfg build/assets.pak
+//
+// Run it from the repository root; build.bash does after linking the hosts.
+
+struct PackItem {
+    PackEntry entry;
+    std::vector<unsigned char> data;
+};
+
+static std::string Trim(const std::string& s) {
+    size_t begin = s.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    size_t end = s.find_last_not_of(" \t\r");
+    return s.substr(begin, end - begin + 1);
+}
+
+static bool IsSound(const std::string& fileName) {
+    size_t dot = fileName.rfind('.');
+    std::string ext = dot == std::string::npos ? "" : fileName.substr(dot);
+    return ext == ".mp3" || ext == ".wav" || ext == ".ogg" || ext == ".flac" || ext == ".qoa";
+}
+
+static bool PackImage(const std::string& fileName, int width, int height, PackItem& item) {
+    Image image = LoadImage(fileName.c_str());
+    if (!image.data) return false;
+    if (width > 0 && height > 0) ImageResize(&image, width, height);
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    item.entry.kind = PACK_TEXTURE;
+    item.entry.width = (uint32_t)image.width;
+    item.entry.height = (uint32_t)image.height;
+    const unsigned char* pixels = (const unsigned char*)image.data;
+    item.data.assign(pixels, pixels + (size_t)image.width * image.height * 4);
+    UnloadImage(image);
+    return true;
+}
+
+static bool PackSound(const std::string& fileName, PackItem& item) {
+    Wave wave = LoadWave(fileName.c_str());
+    if (!wave.data) return false;
+    WaveFormat(&wave, wave.sampleRate, 16, wave.channels);
+    item.entry.kind = PACK_SOUND;
+    item.entry.frameCount = wave.frameCount;
+    item.entry.sampleRate = wave.sampleRate;
+    item.entry.channels = wave.channels;
+    const unsigned char* samples = (const unsigned char*)wave.data;
+    item.data.assign(samples, samples + (size_t)wave.frameCount * wave.channels * 2);
+    UnloadWave(wave);
+    return true;
+}
+
+static bool WritePack(const char* fileName, std::vector<PackItem>& items) {
+    PackHeader header = {};
+    memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+    header.version = PACK_VERSION;
+    header.count = (uint32_t)items.size();
+
+    uint64_t offset = sizeof(PackHeader) + items.size() * sizeof(PackEntry);
+    for (PackItem& item : items) {
+        offset = (offset + PACK_ALIGN - 1) / PACK_ALIGN * PACK_ALIGN;
+        item.entry.offset = offset;
+        item.entry.size = item.data.size();
+        offset += item.data.size();
+    }
+
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write((const char*)&header, sizeof(header));
+    for (const PackItem& item : items) out.write((const char*)&item.entry, sizeof(PackEntry));
+    static const char zeros[PACK_ALIGN] = {};
+    for (const PackItem& item : items) {
+        out.write(zeros, item.entry.offset - (uint64_t)out.tellp());
+        out.write((const char*)item.data.data(), item.data.size());
+    }
+    return (bool)out;
+}
+
+int main(int argc, char** argv) {
+    const char* manifest = argc > 1 ? argv[1] : "assets.cfg";
+    const char* packFile = argc > 2 ? argv[2] : "build/assets.pak";
+    SetTraceLogLevel(LOG_WARNING);
+
+    std::ifstream in(manifest);
+    if (!in) { fprintf(stderr, "cannot read %s\n", manifest); return 1; }
+    std::vector<PackItem> items;
+    std::string line;
+    int failures = 0;
+    while (std::getline(in, line)) {
+        line = Trim(line);
+        if (line.empty() || line[0] == '#') continue;
+        size_t bar = line.find('|');
+        std::string source = Trim(line.substr(0, bar));
+        int width = 0, height = 0;
+        if (bar != std::string::npos && sscanf(Trim(line.substr(bar + 1)).c_str(), "%dx%d", &width, &height) != 2) {
+            fprintf(stderr, "%s: bad size in \"%s\"\n", manifest, line.c_str());
+            failures++;
+            continue;
+        }
+        PackItem item = {};
+        if (source.size() >= sizeof(item.entry.name)) {
+            fprintf(stderr, "%s: name too long\n", source.c_str());
+            failures++;
+            continue;
+        }
+        strcpy(item.entry.name, source.c_str());
+        bool ok = IsSound(source) ? PackSound(source, item) : PackImage(source, width, height, item);
+        if (!ok) { fprintf(stderr, "cannot decode %s\n", source.c_str()); failures++; continue; }
+        items.push_back(std::move(item));
+    }
+
+    if (!WritePack(packFile, items)) { fprintf(stderr, "cannot write %s\n", packFile); return 1; }
+    size_t bytes = 0;
+    for (const PackItem& item : items) bytes += item.data.size();
+    printf("Packed %d assets, %.1f MB, into %s\n", (int)items.size(), bytes / 1048576.0, packFile);
+    return failures == 0 ? 0 : 1;
+}
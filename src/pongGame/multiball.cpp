@@ -0,0 +1,189 @@
+#include "multiball.hpp"
+#include "pong.hpp"
+#include "pongai.hpp"
+#include "../common/assetpack.hpp"
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+
+// Same serve speed as the single ball
+static const float SERVE_SPEED = 300.0f;
+// Paddles a ball is tested against at once; chaos mode has two.
+static const int MAX_PADDLES = 8;
+
+// --- Ball swarm ---
+
+uint32_t PongBallSwarm::NextRandom() {
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return (uint32_t)((rng * 2685821657736338717ULL) >> 32);
+}
+
+// From the middle at up to 45 degrees either way, spread over the middle
+// half of the field so a fresh swarm is not one blob.
+void PongBallSwarm::Serve(int i) {
+    float angle = ((int)(NextRandom() % 91) - 45) * DEG2RAD;
+    float dir = (NextRandom() & 1) ? 1.0f : -1.0f;
+    x[i] = fieldW / 2.0f;
+    y[i] = fieldH / 4.0f + (NextRandom() % 1024) / 1024.0f * fieldH / 2.0f;
+    dirX[i] = dir * cosf(angle);
+    dirY[i] = sinf(angle);
+    speed[i] = SERVE_SPEED;
+    prevX[i] = x[i];
+    prevY[i] = y[i];
+}
+
+void PongBallSwarm::Init(int count, float width, float height, uint64_t seed) {
+    fieldW = width;
+    fieldH = height;
+    rng = seed ? seed : 1;
+    wallHits = paddleHits = narrowTests = 0;
+    goals[0] = goals[1] = 0;
+    urgent[0] = urgent[1] = -1;
+    x.clear();
+    Resize(count);
+}
+
+void PongBallSwarm::Resize(int count) {
+    int old = Count();
+    x.resize(count); y.resize(count);
+    dirX.resize(count); dirY.resize(count);
+    speed.resize(count);
+    prevX.resize(count); prevY.resize(count);
+    for (int i = old; i < count; i++) Serve(i);
+    for (int side = 0; side < 2; side++)
+        if (urgent[side] >= count) urgent[side] = -1;
+}
+
+void PongBallSwarm::Step(const PongPaddleBox* paddles, int paddleCount, float dt) {
+    wallHits = paddleHits = narrowTests = 0;
+    goals[0] = goals[1] = 0;
+    urgent[0] = urgent[1] = -1;
+    float soonest[2] = {INFINITY, INFINITY};
+    if (paddleCount > MAX_PADDLES) paddleCount = MAX_PADDLES;
+    PongPaddleBox near[MAX_PADDLES];
+    const float r = radius;
+
+    for (int i = 0; i < Count(); i++) {
+        prevX[i] = x[i];
+        prevY[i] = y[i];
+        float nx = x[i] + dirX[i] * speed[i] * dt;
+        float ny = y[i] + dirY[i] * speed[i] * dt;
+
+        // broadphase: the box the ball sweeps this step against each paddle
+        float minX = fminf(x[i], nx) - r, maxX = fmaxf(x[i], nx) + r;
+        float minY = fminf(y[i], ny) - r, maxY = fmaxf(y[i], ny) + r;
+        int nearCount = 0;
+        for (int p = 0; p < paddleCount; p++) {
+            const PongPaddleBox& b = paddles[p];
+            if (minX <= b.x + b.width && maxX >= b.x && minY <= b.y + b.height && maxY >= b.y)
+                near[nearCount++] = b;
+        }
+
+        if (nearCount == 0 && minX > 0.0f && maxX < fieldW && minY > 0.0f && maxY < fieldH) {
+            x[i] = nx;
+            y[i] = ny;
+        } else {
+            narrowTests++;
+            PongBody ball = Ball(i);
+            int events = PongStepBall(ball, near, nearCount, fieldW, fieldH, dt);
+            x[i] = ball.position.x;
+            y[i] = ball.position.y;
+            dirX[i] = ball.velocity.x;
+            dirY[i] = ball.velocity.y;
+            speed[i] = ball.speed;
+            if (events & PONG_HIT_WALL) wallHits++;
+            if (events & PONG_HIT_PADDLE) paddleHits++;
+            if (events & PONG_GOAL_RIGHT) { goals[0]++; Serve(i); }
+            if (events & PONG_GOAL_LEFT) { goals[1]++; Serve(i); }
+        }
+
+        // which ball each paddle should worry about next
+        if (dirX[i] > 0.0f) {
+            float t = (fieldW - x[i]) / (dirX[i] * speed[i]);
+            if (t < soonest[0]) { soonest[0] = t; urgent[0] = i; }
+        } else if (dirX[i] < 0.0f) {
+            float t = x[i] / (-dirX[i] * speed[i]);
+            if (t < soonest[1]) { soonest[1] = t; urgent[1] = i; }
+        }
+    }
+}
+
+void PongBallSwarm::Draw(float alpha) const {
+    static const Color colors[8] = {RED, ORANGE, YELLOW, GREEN, SKYBLUE, BLUE, PURPLE, PINK};
+    for (int i = 0; i < Count(); i++) {
+        Vector2 at = {prevX[i] + (x[i] - prevX[i]) * alpha, prevY[i] + (y[i] - prevY[i]) * alpha};
+        DrawCircleV(at, radius, colors[i & 7]);
+    }
+}
+
+uint64_t PongBallSwarm::Checksum() const {
+    uint64_t h = 1469598103934665603ULL; // FNV-1a
+    auto mix = [&h](uint64_t v) { h = (h ^ v) * 1099511628211ULL; };
+    for (int i = 0; i < Count(); i++) {
+        mix((uint64_t)(int64_t)(x[i] * 16.0f));
+        mix((uint64_t)(int64_t)(y[i] * 16.0f));
+    }
+    return h;
+}
+
+// --- Sound pool ---
+
+// one decode, shared by every voice
+void PongSoundPool::Load(const char* fileName, int voiceCount) {
+    Wave wave = Assets().LoadWave(fileName);
+    for (int i = 0; i < voiceCount; i++) voices.push_back(LoadSoundFromWave(wave));
+    UnloadWave(wave);
+    next = 0;
+    pending = 0;
+}
+
+void PongSoundPool::Unload() {
+    for (Sound& s : voices) UnloadSound(s);
+    voices.clear();
+}
+
+void PongSoundPool::Flush() {
+    if (pending > 0 && !voices.empty()) {
+        Sound& voice = voices[next];
+        next = (next + 1) % (int)voices.size();
+        SetSoundVolume(voice, fminf(1.0f, 0.5f + 0.1f * log2f((float)pending)));
+        PlaySound(voice);
+    }
+    pending = 0;
+}
+
+// --- Benchmark ---
+
+int RunPongChaosBench(int maxBalls) {
+    const float w = 1200.0f, h = 800.0f;
+    const int steps = 1200; // ten seconds of play
+    printf("%d steps of %.1f ms on %.0fx%.0f, AI paddles at both ends\n", steps, PONG_STEP * 1000.0f, w, h);
+    printf("%8s %12s %10s %10s %10s %18s\n", "balls", "balls/ms", "narrow %", "hits", "goals", "checksum");
+    PongBallSwarm swarm;
+    for (int balls = 64; balls <= maxBalls; balls *= 2) {
+        swarm.Init(balls, w, h, 12345);
+        PongAiParams params;
+        PongAiMemory memory[2];
+        PongPaddleBox paddles[2] = {{w - 35.0f, h / 2.0f - 60.0f, 25.0f, 120.0f}, {10.0f, h / 2.0f - 60.0f, 25.0f, 120.0f}};
+        long long narrow = 0, hits = 0, goals = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int s = 0; s < steps; s++) {
+            for (int p = 0; p < 2; p++) {
+                int target = swarm.Urgent(p);
+                PongBody ball = target >= 0 ? swarm.Ball(target) : PongBody{{w / 2.0f, h / 2.0f}, {0, 0}, 0, 0};
+                paddles[p].y += PongAiDecide(params, memory[p], paddles[p], ball, h) * 400.0f * PONG_STEP;
+                paddles[p].y = fminf(fmaxf(paddles[p].y, 10.0f), h - paddles[p].height - 10.0f);
+            }
+            swarm.Step(paddles, 2, PONG_STEP);
+            narrow += swarm.NarrowTests();
+            hits += swarm.WallHits() + swarm.PaddleHits();
+            goals += swarm.Goals(0) + swarm.Goals(1);
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        printf("%8d %12.0f %9.1f%% %10lld %10lld %18llx\n", balls, (double)balls * steps / ms,
+               100.0 * narrow / ((double)balls * steps), hits, goals, (unsigned long long)swarm.Checksum());
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "raylib.h"
+#include "pongphysics.hpp"
+#include <vector>
+#include <cstdint>
+
+// Chaos mode: many balls at once. Balls are kept as parallel arrays, indexed
+// by ball, so a step walks memory in order. Each step a ball's swept box is
+// tested against the walls and the paddle boxes first. Balls that touch
+// nothing, which is nearly all of them, just move in a straight line. Only
+// the rest go through the full swept collision in PongStepBall, and then
+// only with the paddles they might reach.
+class PongBallSwarm {
+    private:
+        float fieldW;
+        float fieldH;
+        float radius;
+        uint64_t rng;
+
+        // balls, structure of arrays
+        std::vector<float> x, y;
+        std::vector<float> dirX, dirY;    // unit direction
+        std::vector<float> speed;
+        std::vector<float> prevX, prevY;  // at the previous step, for drawing between steps
+
+        // event counts from the last step
+        int wallHits;
+        int paddleHits;
+        int goals[2];                     // [0] out through x = fieldW, [1] through x = 0
+        int narrowTests;                  // balls that needed the full swept test
+        int urgent[2];                    // ball nearest to reaching each side, -1 for none
+
+        uint32_t NextRandom();
+        void Serve(int i);
+
+    public:
+        PongBallSwarm()
+        : fieldW(0), fieldH(0), radius(8), rng(1), wallHits(0), paddleHits(0), goals{0, 0}, narrowTests(0), urgent{-1, -1} {};
+        void Init(int count, float width, float height, uint64_t seed);
+        // Grows or shrinks the swarm; new balls are served from the middle.
+        void Resize(int count);
+        // One fixed step. A ball that leaves through either end is served again.
+        void Step(const PongPaddleBox* paddles, int paddleCount, float dt);
+        void Draw(float alpha) const;
+
+        int Count() const {return (int)x.size();}
+        int WallHits() const {return wallHits;}
+        int PaddleHits() const {return paddleHits;}
+        int Goals(int side) const {return goals[side];}
+        int NarrowTests() const {return narrowTests;}
+        // Ball heading for side 0 (right) or 1 (left) that gets there first, -1 for none.
+        int Urgent(int side) const {return urgent[side];}
+        PongBody Ball(int i) const {return {{x[i], y[i]}, {dirX[i], dirY[i]}, speed[i], radius};}
+        // Hash of every ball's position; equal runs give equal values.
+        uint64_t Checksum() const;
+};
+
+// Several copies of one sound, played round-robin. Callers Trigger() as
+// often as they like during a frame; Flush() then starts at most one copy,
+// louder the more triggers it collected, so a thousand bounces in a frame
+// cost one PlaySound rather than a thousand.
+class PongSoundPool {
+    private:
+        std::vector<Sound> voices;
+        int next;
+        int pending;
+
+    public:
+        PongSoundPool() : next(0), pending(0) {};
+        void Load(const char* fileName, int voiceCount);
+        void Unload();
+        void Trigger(int count = 1) {pending += count;}
+        void Flush();
+};
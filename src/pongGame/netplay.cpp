@@ -0,0 +1,373 @@
+#include "netplay.hpp"
+#include "pong.hpp"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+// Same numbers as the local game's paddles and ball
+static const float PADDLE_W = 25.0f;
+static const float PADDLE_H = 120.0f;
+static const float PADDLE_SPEED = 400.0f;
+static const float BALL_RADIUS = 20.0f;
+static const float BALL_SPEED = 300.0f;
+
+// --- Deterministic simulation ---
+
+static uint32_t NextRandom(uint32_t& r) {
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    return r;
+}
+
+void PongNetServe(PongNetState& s) {
+    s.ball.position = {s.fieldW / 2.0f, s.fieldH / 2.0f};
+    s.ball.radius = BALL_RADIUS;
+    s.ball.speed = BALL_SPEED;
+    float angle = ((int)(NextRandom(s.rng) % 91) - 45) * DEG2RAD;
+    float dir = (NextRandom(s.rng) & 1) ? 1.0f : -1.0f;
+    s.ball.velocity = {dir * cosf(angle), sinf(angle)};
+}
+
+void PongNetInit(PongNetState& s, uint32_t seed, float fieldW, float fieldH, int winScore) {
+    memset(&s, 0, sizeof(s));
+    s.fieldW = fieldW;
+    s.fieldH = fieldH;
+    s.winScore = winScore;
+    s.rng = seed ? seed : 1;
+    s.paddleY[0] = s.paddleY[1] = fieldH / 2.0f - PADDLE_H / 2.0f;
+    s.paddleSpeed[0] = s.paddleSpeed[1] = 1.0f;
+    PongNetServe(s);
+}
+
+bool PongNetOver(const PongNetState& s) {
+    return s.score[0] >= s.winScore || s.score[1] >= s.winScore;
+}
+
+PongPaddleBox PongNetPaddle(const PongNetState& s, int player) {
+    float x = player == 0 ? s.fieldW - PADDLE_W - 10.0f : 10.0f;
+    return {x, s.paddleY[player], PADDLE_W, PADDLE_H};
+}
+
+int PongNetStep(PongNetState& s, uint8_t input1, uint8_t input2) {
+    const uint8_t inputs[2] = {input1, input2};
+    for (int p = 0; p < 2; p++) {
+        float step = PADDLE_SPEED * s.paddleSpeed[p] * PONG_STEP;
+        if (inputs[p] & PONG_IN_UP) s.paddleY[p] -= step;
+        if (inputs[p] & PONG_IN_DOWN) s.paddleY[p] += step;
+        s.paddleY[p] = std::min(std::max(s.paddleY[p], 10.0f), s.fieldH - PADDLE_H - 10.0f);
+    }
+    int events = 0;
+    if (s.frame >= PONG_SERVE_FRAMES && !PongNetOver(s)) {
+        PongPaddleBox paddles[2] = {PongNetPaddle(s, 0), PongNetPaddle(s, 1)};
+        events = PongStepBall(s.ball, paddles, 2, s.fieldW, s.fieldH, PONG_STEP);
+        // scored the same way as the local game
+        if (events & PONG_GOAL_LEFT) { s.score[1]++; PongNetServe(s); }
+        if (events & PONG_GOAL_RIGHT) { s.score[0]++; PongNetServe(s); }
+    }
+    s.frame++;
+    return events;
+}
+
+// --- Session ---
+
+namespace {
+    const uint32_t PACKET_MAGIC = 0x31474E50; // "PNG1"
+
+    struct PacketHeader {
+        uint32_t magic;
+        uint32_t seed;      // player 1's seed; 0 from player 2
+        int32_t frame;      // sender's next frame
+        int32_t ack;        // sender has our inputs up to here
+        int32_t first;      // frame of the first input that follows
+        uint32_t stamp;     // sender's clock, ms
+        uint32_t echo;      // latest stamp the sender got from us
+        uint8_t count;
+    };
+}
+
+PongNetSession::PongNetSession()
+: sock(-1), peerAddr(0), peerPort(0), localPlayer(0), connected(false), seed(0), startTime(0),
+  localLatest(0), confirmedRemote(0), remoteAck(-1), remoteFrame(0), rollbackFrom(-1), lastPeerStamp(0),
+  lagMs(0), jitterMs(0), lossPercent(0), shimRng(0x9E3779B9u),
+  rollbacks(0), resimulated(0), longestRollback(0), stalls(0), rttMs(0) {
+    memset(&state, 0, sizeof(state));
+}
+
+double PongNetSession::Now() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint32_t PongNetSession::NextShimRandom() {
+    return NextRandom(shimRng);
+}
+
+bool PongNetSession::Start(int localPort, const char* host, int remotePort, int player, float fieldW, float fieldH, int winScore) {
+    Stop();
+    addrinfo hints, *found = nullptr;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    if (getaddrinfo(host, nullptr, &hints, &found) != 0 || !found) return false;
+    peerAddr = ((sockaddr_in*)found->ai_addr)->sin_addr.s_addr;
+    freeaddrinfo(found);
+    peerPort = htons((uint16_t)remotePort);
+
+    sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) return false;
+    sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons((uint16_t)localPort);
+    if (bind(sock, (sockaddr*)&local, sizeof(local)) != 0 ||
+        fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK) != 0) {
+        Stop();
+        return false;
+    }
+
+    localPlayer = player ? 1 : 0;
+    connected = false;
+    startTime = Now();
+    seed = localPlayer == 0 ? (uint32_t)std::chrono::steady_clock::now().time_since_epoch().count() | 1u : 0;
+    PongNetInit(state, seed, fieldW, fieldH, winScore);
+    // the first INPUT_DELAY frames have no input on either side
+    memset(localInputs, 0, sizeof(localInputs));
+    memset(remoteInputs, 0, sizeof(remoteInputs));
+    memset(usedRemote, 0, sizeof(usedRemote));
+    localLatest = INPUT_DELAY - 1;
+    confirmedRemote = INPUT_DELAY - 1;
+    remoteAck = -1;
+    remoteFrame = 0;
+    rollbackFrom = -1;
+    lastPeerStamp = 0;
+    outbox.clear();
+    rollbacks = resimulated = longestRollback = stalls = 0;
+    rttMs = 0;
+    return true;
+}
+
+void PongNetSession::Stop() {
+    if (sock >= 0) close(sock);
+    sock = -1;
+    connected = false;
+    outbox.clear();
+}
+
+// Sends every input the peer has not acknowledged, through the shim.
+void PongNetSession::SendPacket() {
+    PacketHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = PACKET_MAGIC;
+    h.seed = seed;
+    h.frame = state.frame;
+    h.ack = confirmedRemote;
+    h.first = std::max(remoteAck + 1, localLatest - WINDOW + 1);
+    h.count = (uint8_t)std::max(0, localLatest - h.first + 1);
+    h.stamp = (uint32_t)((Now() - startTime) * 1000.0) + 1;
+    h.echo = lastPeerStamp;
+
+    Delayed d;
+    static_assert(sizeof(PacketHeader) + WINDOW <= sizeof(d.bytes), "packet buffer too small");
+    memcpy(d.bytes, &h, sizeof(h));
+    for (int i = 0; i < h.count; i++) d.bytes[sizeof(h) + i] = localInputs[(h.first + i) % WINDOW];
+    d.length = (int)sizeof(h) + h.count;
+
+    if (lossPercent > 0 && NextShimRandom() % 10000 < (uint32_t)(lossPercent * 100.0f)) return;
+    int delay = lagMs + (jitterMs > 0 ? (int)(NextShimRandom() % (uint32_t)(jitterMs + 1)) : 0);
+    d.sendAt = Now() + delay / 1000.0;
+    outbox.push_back(d);
+}
+
+void PongNetSession::FlushOutbox() {
+    sockaddr_in to;
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_addr.s_addr = peerAddr;
+    to.sin_port = peerPort;
+    double now = Now();
+    size_t kept = 0;
+    for (size_t i = 0; i < outbox.size(); i++) {
+        if (outbox[i].sendAt <= now) sendto(sock, outbox[i].bytes, outbox[i].length, 0, (sockaddr*)&to, sizeof(to));
+        else outbox[kept++] = outbox[i];
+    }
+    outbox.resize(kept);
+}
+
+void PongNetSession::Receive() {
+    uint8_t buf[256];
+    sockaddr_in from;
+    socklen_t fromLen = sizeof(from);
+    ssize_t n;
+    while ((n = recvfrom(sock, buf, sizeof(buf), 0, (sockaddr*)&from, &fromLen)) > 0) {
+        fromLen = sizeof(from);
+        PacketHeader h;
+        if (n < (ssize_t)sizeof(h)) continue;
+        memcpy(&h, buf, sizeof(h));
+        if (h.magic != PACKET_MAGIC || n < (ssize_t)sizeof(h) + h.count) continue;
+        if (from.sin_addr.s_addr != peerAddr || from.sin_port != peerPort) continue;
+
+        if (!connected) {
+            // player 2 adopts player 1's seed; both start from frame 0
+            if (localPlayer == 1) {
+                if (h.seed == 0) continue;
+                seed = h.seed;
+            }
+            PongNetInit(state, seed, state.fieldW, state.fieldH, state.winScore);
+            connected = true;
+        }
+        remoteFrame = std::max(remoteFrame, h.frame);
+        remoteAck = std::max(remoteAck, h.ack);
+        lastPeerStamp = std::max(lastPeerStamp, h.stamp);
+        if (h.echo) {
+            double rtt = (Now() - startTime) * 1000.0 + 1 - h.echo;
+            rttMs = rttMs > 0 ? rttMs * 0.9 + rtt * 0.1 : rtt;
+        }
+        // take inputs in order only, so everything up to confirmedRemote is known
+        for (int i = 0; i < h.count; i++) {
+            int32_t f = h.first + i;
+            if (f != confirmedRemote + 1) continue;
+            uint8_t input = buf[sizeof(h) + i];
+            remoteInputs[f % WINDOW] = input;
+            confirmedRemote = f;
+            if (f < state.frame && usedRemote[f % WINDOW] != input && (rollbackFrom < 0 || f < rollbackFrom))
+                rollbackFrom = f;
+        }
+    }
+}
+
+// Simulates state.frame with the local input and the known or predicted
+// remote input, keeping the snapshot taken before it.
+int PongNetSession::Simulate() {
+    int32_t f = state.frame;
+    snapshots[f % WINDOW] = state;
+    uint8_t remote = f <= confirmedRemote ? remoteInputs[f % WINDOW] : remoteInputs[confirmedRemote % WINDOW];
+    usedRemote[f % WINDOW] = remote;
+    uint8_t local = localInputs[f % WINDOW];
+    return localPlayer == 0 ? PongNetStep(state, local, remote) : PongNetStep(state, remote, local);
+}
+
+const PongNetState& PongNetSession::ConfirmedState() const {
+    if (confirmedRemote + 1 >= state.frame) return state;
+    return snapshots[(confirmedRemote + 1) % WINDOW];
+}
+
+int PongNetSession::Tick(uint8_t localInput) {
+    if (sock < 0) return 0;
+    Receive();
+    if (!connected) {
+        SendPacket();
+        FlushOutbox();
+        return 0;
+    }
+    if (localLatest < state.frame + INPUT_DELAY) {
+        localLatest++;
+        localInputs[localLatest % WINDOW] = localInput;
+    }
+    SendPacket();
+
+    // Replay from the first wrong guess; events of replayed frames were
+    // already reported once
+    if (rollbackFrom >= 0) {
+        int32_t target = state.frame;
+        state = snapshots[rollbackFrom % WINDOW];
+        while (state.frame < target) { Simulate(); resimulated++; }
+        rollbacks++;
+        longestRollback = std::max(longestRollback, target - rollbackFrom);
+        rollbackFrom = -1;
+    }
+
+    // Wait when a rollback could reach past the kept snapshots and inputs,
+    // or when the peer has not acknowledged a window's worth of our inputs:
+    // SendPacket() can only resend the last WINDOW, and the peer takes them
+    // in order, so running further would strand it. Also wait now and then
+    // when running ahead of the peer, so its inputs stop arriving late
+    int events = 0;
+    bool outOfWindow = state.frame + INPUT_DELAY - (confirmedRemote + 1) >= WINDOW - 1
+                    || localLatest - remoteAck >= WINDOW - 1;
+    int32_t peerNow = remoteFrame + (int32_t)(rttMs / 2000.0 / PONG_STEP);
+    bool ahead = state.frame - peerNow > 2 && state.frame % 4 == 0;
+    if (outOfWindow || ahead) stalls++;
+    else events = Simulate();
+    FlushOutbox();
+    return events;
+}
+
+// --- Loss-burst check ---
+
+static uint64_t HashState(const PongNetState& s) {
+    const unsigned char* bytes = (const unsigned char*)&s;
+    uint64_t h = 1469598103934665603ULL; // FNV-1a
+    for (size_t i = 0; i < sizeof(s); i++) h = (h ^ bytes[i]) * 1099511628211ULL;
+    return h;
+}
+
+// Notes the hash of each confirmed frame a session reaches.
+static void NoteConfirmed(const PongNetSession& session, std::vector<uint64_t>& hashes) {
+    const PongNetState& c = session.ConfirmedState();
+    if (c.frame < (int32_t)hashes.size() && hashes[c.frame] == 0) hashes[c.frame] = HashState(c);
+}
+
+int RunPongNetBurst(int basePort) {
+    // Ticks run in real time, as the rtt estimate and the shim's lag are
+    // wall-clock: with no lag the sessions freeze each other within a few
+    // frames and a burst proves nothing
+    const float outages[] = {0.75f, 2.5f, 5.0f};    // seconds of a->b loss
+    const int lagMs = 30, jitterMs = 15;
+    const int32_t outageAt = (int32_t)(1.0f / PONG_STEP);
+    const int32_t target = outageAt + (int32_t)(3.0f / PONG_STEP);
+    int failures = 0;
+    printf("two sessions on 127.0.0.1:%d-%d, %d+%d ms each way, every packet from player 1 dropped for a while\n",
+           basePort, basePort + 1, lagMs, jitterMs);
+    printf("%10s %10s %10s %10s %10s %10s\n", "outage s", "ticks", "stalls 1", "stalls 2", "compared", "result");
+    for (float outage : outages) {
+        PongNetSession a, b;
+        if (!a.Start(basePort, "127.0.0.1", basePort + 1, 0, 1200.0f, 800.0f, 1000) ||
+            !b.Start(basePort + 1, "127.0.0.1", basePort, 1, 1200.0f, 800.0f, 1000)) {
+            printf("cannot open UDP ports %d and %d\n", basePort, basePort + 1);
+            return 1;
+        }
+        b.SetConditions(lagMs, jitterMs, 0.0f);
+        std::vector<uint64_t> hashA(target + 1, 0), hashB(target + 1, 0);
+        uint32_t rng = 12345;
+        long long ticks = 0, outageTicks = (long long)(outage / PONG_STEP), outageLeft = -1;
+        // a recovered session reaches the target within a few seconds of the outage
+        long long tickLimit = target + outageTicks + (long long)(5.0f / PONG_STEP);
+        auto begin = std::chrono::steady_clock::now();
+        while (ticks < tickLimit && (a.ConfirmedState().frame < target || b.ConfirmedState().frame < target)) {
+            // the outage runs for a fixed time, however far the frames get
+            if (outageLeft < 0 && a.State().frame >= outageAt) outageLeft = outageTicks;
+            a.SetConditions(lagMs, jitterMs, outageLeft > 0 ? 100.0f : 0.0f);
+            if (outageLeft > 0) outageLeft--;
+            a.Tick((uint8_t)(NextRandom(rng) % 3));
+            b.Tick((uint8_t)(NextRandom(rng) % 3));
+            if (a.Connected()) NoteConfirmed(a, hashA);
+            if (b.Connected()) NoteConfirmed(b, hashB);
+            ticks++;
+            std::this_thread::sleep_until(begin + std::chrono::duration<double>(ticks * PONG_STEP));
+        }
+        bool finished = a.ConfirmedState().frame >= target && b.ConfirmedState().frame >= target;
+        int compared = 0, differing = 0;
+        for (int32_t f = 0; f <= target; f++) {
+            if (!hashA[f] || !hashB[f]) continue;
+            compared++;
+            if (hashA[f] != hashB[f]) differing++;
+        }
+        bool ok = finished && compared > 0 && differing == 0;
+        if (!ok) failures++;
+        printf("%10.2f %10lld %10d %10d %10d %10s", outage, ticks, a.Stalls(), b.Stalls(), compared,
+               ok ? "ok" : !finished ? "STUCK" : "DIVERGED");
+        if (!finished) printf("  at frames %d/%d", a.State().frame, b.State().frame);
+        printf("\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include "pongphysics.hpp"
+#include <cstdint>
+#include <vector>
+
+// Two-player Pong over UDP with rollback.
+//
+// Both peers run the same deterministic simulation from the same seed. Each
+// tick a peer sends its own inputs and simulates at once, predicting that
+// the other player is still pressing whatever they pressed last. When the
+// real input for an already simulated frame arrives and differs, the
+// session restores that frame's snapshot and replays every frame since.
+//
+// Packets carry every input the peer has not acknowledged yet, so losses
+// only delay confirmation, and they never leave gaps. A peer stalls rather
+// than get a window ahead of the peer's acknowledgements, since older
+// inputs could no longer be resent.
+
+// One player's input for one tick
+enum PongInputBits : uint8_t {
+    PONG_IN_UP   = 1,
+    PONG_IN_DOWN = 2,
+};
+
+// The whole simulation state. Kept POD so a snapshot is one copy.
+struct PongNetState {
+    PongBody ball;
+    float paddleY[2];   // [0] right paddle (player 1), [1] left paddle (player 2)
+    float paddleSpeed[2]; // multiplier on the paddle speed, 1 in normal play
+    int score[2];
+    float fieldW, fieldH;
+    int winScore;       // play stops once a side reaches this
+    uint32_t rng;
+    int32_t frame;      // next frame to simulate
+};
+
+// Frames before the first serve, so both players see the countdown.
+static const int PONG_SERVE_FRAMES = (int)(3.0f / PONG_STEP);
+
+void PongNetInit(PongNetState& s, uint32_t seed, float fieldW, float fieldH, int winScore);
+bool PongNetOver(const PongNetState& s);
+// Puts the ball back in the middle with a new random direction.
+void PongNetServe(PongNetState& s);
+// Advances one frame; returns PongEvent flags.
+int PongNetStep(PongNetState& s, uint8_t input1, uint8_t input2);
+PongPaddleBox PongNetPaddle(const PongNetState& s, int player);
+
+class PongNetSession {
+    public:
+        static const int WINDOW = 64;      // frames of snapshots and inputs kept
+        static const int INPUT_DELAY = 2;  // local inputs apply this many frames later
+
+    private:
+        struct Delayed {
+            double sendAt;
+            int length;
+            uint8_t bytes[128];
+        };
+
+        int sock;
+        uint32_t peerAddr;    // network byte order
+        uint16_t peerPort;
+        int localPlayer;      // 0 or 1
+        bool connected;
+        uint32_t seed;
+        double startTime;
+
+        PongNetState state;
+        PongNetState snapshots[WINDOW];   // state before simulating frame f, at f % WINDOW
+        uint8_t localInputs[WINDOW];
+        uint8_t remoteInputs[WINDOW];
+        uint8_t usedRemote[WINDOW];       // remote input the frame was simulated with
+        int32_t localLatest;              // newest frame with a local input
+        int32_t confirmedRemote;          // remote inputs known up to here
+        int32_t remoteAck;                // peer has our inputs up to here
+        int32_t remoteFrame;              // peer's frame in its latest packet
+        int32_t rollbackFrom;             // earliest mispredicted frame, -1 for none
+        uint32_t lastPeerStamp;
+
+        // latency/loss shim on the send path
+        std::vector<Delayed> outbox;
+        int lagMs;
+        int jitterMs;
+        float lossPercent;
+        uint32_t shimRng;
+
+        // stats
+        int rollbacks;
+        int resimulated;
+        int longestRollback;
+        int stalls;
+        double rttMs;
+
+        double Now() const;
+        uint32_t NextShimRandom();
+        void SendPacket();
+        void FlushOutbox();
+        void Receive();
+        int Simulate();
+
+    public:
+        PongNetSession();
+        ~PongNetSession() {Stop();}
+        // localPlayer 0 plays the right paddle and picks the seed.
+        bool Start(int localPort, const char* host, int remotePort, int player, float fieldW, float fieldH, int winScore);
+        void Stop();
+        // Artificial one-way delay, random extra delay and drop rate for
+        // outgoing packets, to try bad networks over loopback.
+        void SetConditions(int lag, int jitter, float loss) {lagMs = lag; jitterMs = jitter; lossPercent = loss;}
+
+        // One fixed step: exchanges inputs, rolls back if a prediction was
+        // wrong, then simulates the next frame unless too far ahead of the
+        // peer. Returns the new frame's PongEvent flags.
+        int Tick(uint8_t localInput);
+
+        const PongNetState& State() const {return state;}
+        // Latest state that no rollback can change: every input before it is known.
+        const PongNetState& ConfirmedState() const;
+        bool Active() const {return sock >= 0;}
+        bool Connected() const {return connected;}
+        int LocalPlayer() const {return localPlayer;}
+        int Rollbacks() const {return rollbacks;}
+        int Resimulated() const {return resimulated;}
+        int LongestRollback() const {return longestRollback;}
+        int Stalls() const {return stalls;}
+        int PredictedFrames() const {return state.frame - 1 - confirmedRemote > 0 ? state.frame - 1 - confirmedRemote : 0;}
+        double RttMs() const {return rttMs;}
+};
@@ -1,9 +1,26 @@
 #include "pong.hpp"
+#include "pongphysics.hpp"
+#include "netplay.hpp"
+#include "pongai.hpp"
+#include "multiball.hpp"
+#include "../common/simthread.hpp"
+#include "../common/triplebuffer.hpp"
+#include "../common/assetpack.hpp"
+#include "../common/session.hpp"
 #include <cmath>
+#include <string>
+#include <chrono>
+#include <atomic>
 
 // Game settings
 enum class PongState { Title, Countdown, Playing, GameOver };
 static const int WIN_SCORE = 6;
+// Longest frame simulated in full; slower frames run the game in slow motion
+// rather than piling up steps.
+static const float MAX_FRAME_TIME = 0.25f;
+// Chaos mode ball counts, doubled and halved with RIGHT/LEFT
+static const int CHAOS_MIN_BALLS = 16;
+static const int CHAOS_MAX_BALLS = 8192;
 
 // Module state
 namespace {
@@ -11,80 +28,185 @@ namespace {
     int player1Score;
     int player2Score;
     double countdownStart;
+    float accumulator;        // frame time not yet simulated
+    double suspendedAt = -1;  // while the window is in the background
 
     Sound hitSound;
     Sound scoreSound;
 
-    struct Ball {
-        Vector2 position;
-        Vector2 velocity;
-        float speed;
-        int radius;
+    // Network two-player, set up from the command line
+    struct NetConfig {
+        bool enabled = false;
+        int localPort = 0;
+        std::string host;
+        int remotePort = 0;
+        int player = 0;
+        int lagMs = 0;
+        int jitterMs = 0;
+        float lossPercent = 0;
+        bool failed = false;    // last Start() could not open the socket
+    } netConfig;
+    PongNetSession net;
+    PongAiParams aiParams;
+
+    // Multi-ball chaos mode
+    bool chaos = false;
+    int chaosBalls = 256;
+    PongBallSwarm swarm;
+    PongSoundPool hitPool;      // shared by every ball's bounces
+    PongSoundPool scorePool;
+    double chaosStepMs = 0;     // time spent stepping balls since the last readout
+    long long chaosBallSteps = 0;
+    double chaosRateAt = 0;
+    float chaosBallsPerMs = 0;  // shown on screen, refreshed twice a second
+
+    struct Ball : PongBody {
+        Vector2 prevPosition;   // at the previous step, for drawing between steps
+        uint64_t rng;           // serves after a goal happen on the simulation thread
 
         void Init(int w, int h) {
             radius = 20;
-            position = { w/2.0f, h/2.0f };
             speed = 300.0f;
-            float angle = GetRandomValue(-45, 45) * DEG2RAD;
-            int dir = GetRandomValue(0,1) ? 1 : -1;
+            rng = (uint64_t)Session().Random(1, 1 << 30);
+            Reset(w,h);
+        }
+        void Reset(int w, int h) {
+            rng ^= rng >> 12; rng ^= rng << 25; rng ^= rng >> 27;
+            uint32_t r = (uint32_t)((rng * 2685821657736338717ULL) >> 32);
+            float angle = ((int)(r % 91) - 45) * DEG2RAD;
+            int dir = (r >> 16) & 1 ? 1 : -1;
+            position = { w/2.0f, h/2.0f };
             velocity = { dir * cosf(angle), sinf(angle) };
+            prevPosition = position;
         }
-        void Reset(int w, int h) { Init(w,h); }
-        void Update(float dt, int w, int h) {
-            position.x += velocity.x * speed * dt;
-            position.y += velocity.y * speed * dt;
-            // top/bottom bounce
-            if (position.y - radius <= 0) {
-                position.y = radius; velocity.y *= -1; PlaySound(hitSound);
-            }
-            if (position.y + radius >= h) {
-                position.y = h - radius; velocity.y *= -1; PlaySound(hitSound);
-            }
+        // Returns the PongStepBall events; sounds are left to the caller.
+        int Update(float dt, int w, int h, const PongPaddleBox* paddles, int count) {
+            prevPosition = position;
+            int events = PongStepBall(*this, paddles, count, (float)w, (float)h, dt);
             // score
-            if (position.x - radius <= 0) {
-                player2Score++; PlaySound(scoreSound); Reset(w,h);
-            }
-            if (position.x + radius >= w) {
-                player1Score++; PlaySound(scoreSound); Reset(w,h);
-            }
-        }
-        void Draw() const { DrawCircleV(position, radius, RED); }
-        void Collide(const Rectangle& paddleRect) {
-            PlaySound(hitSound);
-            velocity.x *= -1;
-            float center = paddleRect.y + paddleRect.height/2.0f;
-            float diff = (position.y - center) / (paddleRect.height/2.0f);
-            float angle = diff * 45.0f * DEG2RAD;
-            int dir = velocity.x < 0 ? -1 : 1;
-            velocity.x = dir * cosf(angle);
-            velocity.y = sinf(angle);
-            speed *= 1.05f;
+            if (events & PONG_GOAL_LEFT) { player2Score++; Reset(w,h); }
+            if (events & PONG_GOAL_RIGHT) { player1Score++; Reset(w,h); }
+            return events;
         }
     } ball;
 
     struct Paddle {
         float x,y,width,height,speed;
+        float prevY;
         bool isPlayer;
+        PongAiMemory ai;
         void Init(int w, int h, bool player) {
             width=25; height=120; speed=400;
             y = h/2.0f - height/2.0f;
             x = player ? w - width - 10 : 10;
             isPlayer = player;
+            prevY = y;
+            ai = PongAiMemory();
         }
-        void Update(float dt, int h, float ballY=0) {
+        // keys: PONG_IN_UP / PONG_IN_DOWN held by the player
+        void Update(float dt, int h, const PongBody& ball, uint8_t keys) {
+            prevY = y;
             if (isPlayer) {
-                if (IsKeyDown(KEY_UP)) y -= speed*dt;
-                if (IsKeyDown(KEY_DOWN)) y += speed*dt;
+                if (keys & PONG_IN_UP) y -= speed*dt;
+                if (keys & PONG_IN_DOWN) y += speed*dt;
             } else {
-                float center = y + height/2.0f;
-                if (center < ballY) y += speed*dt; else y -= speed*dt;
+                y += PongAiDecide(aiParams, ai, Box(), ball, (float)h) * speed * aiParams.speed * dt;
             }
             if (y < 10) y = 10;
             if (y + height > h - 10) y = h - height - 10;
         }
-        void Draw() const { DrawRectangleRounded({x,y,width,height}, 0.8f, 0, WHITE); }
-        Rectangle Rect() const { return { x,y,width,height }; }
+        void Draw(float alpha) const { DrawRectangleRounded({x,prevY + (y-prevY)*alpha,width,height}, 0.8f, 0, WHITE); }
+        PongPaddleBox Box() const { return { x,y,width,height }; }
     } player1, player2;
+
+    // Local play runs on the simulation thread, so its timing does not
+    // depend on the display. While the match runs the thread owns ball,
+    // player1, player2 and the scores: the main thread passes the held keys
+    // in matchKeys, and draws and plays sounds from the published frames.
+    struct MatchFrame {
+        Vector2 ball, prevBall;
+        float paddleY[2], prevPaddleY[2];
+        int score[2];
+        int hits, goals;        // running totals, for the sounds
+        double time;            // SimThread::Now() when the step finished
+    };
+    SimThread matchThread;
+    TripleBuffer<MatchFrame> matchFrames;
+    std::atomic<uint8_t> matchKeys;
+    int matchHits, matchGoals;  // simulation thread's totals
+    int soundedHits, soundedGoals;
+    int fieldW, fieldH;
+}
+
+static uint8_t HeldKeys() {
+    return (Session().KeyDown(KEY_UP) ? PONG_IN_UP : 0) | (Session().KeyDown(KEY_DOWN) ? PONG_IN_DOWN : 0);
+}
+
+// --- Local match ---
+static void FillMatchFrame(MatchFrame& f) {
+    f.ball = ball.position;
+    f.prevBall = ball.prevPosition;
+    f.paddleY[0] = player1.y; f.prevPaddleY[0] = player1.prevY;
+    f.paddleY[1] = player2.y; f.prevPaddleY[1] = player2.prevY;
+    f.score[0] = player1Score;
+    f.score[1] = player2Score;
+    f.hits = matchHits;
+    f.goals = matchGoals;
+    f.time = SimThread::Now();
+}
+
+// One fixed step, on matchThread; stops stepping once someone has won.
+static void StepMatch() {
+    if (player1Score >= WIN_SCORE || player2Score >= WIN_SCORE) return;
+    uint8_t keys = matchKeys.load(std::memory_order_relaxed);
+    player1.Update(PONG_STEP, fieldH, ball, keys);
+    player2.Update(PONG_STEP, fieldH, ball, 0);
+    PongPaddleBox paddles[2] = { player1.Box(), player2.Box() };
+    int events = ball.Update(PONG_STEP, fieldW, fieldH, paddles, 2);
+    if (events & (PONG_HIT_WALL | PONG_HIT_PADDLE)) matchHits++;
+    if (events & (PONG_GOAL_LEFT | PONG_GOAL_RIGHT)) matchGoals++;
+    FillMatchFrame(matchFrames.Back());
+    matchFrames.Publish();
+}
+
+static void StartMatch() {
+    fieldW = GetScreenWidth();
+    fieldH = GetScreenHeight();
+    matchHits = matchGoals = soundedHits = soundedGoals = 0;
+    matchKeys.store(HeldKeys());
+    MatchFrame first;
+    FillMatchFrame(first);
+    matchFrames.Reset(first);
+    matchThread.Start(PONG_STEP, StepMatch);
+}
+
+// Newest frame in, its sounds played; true once the match is won.
+static bool FollowMatch() {
+    matchKeys.store(HeldKeys(), std::memory_order_relaxed);
+    matchThread.Pump();
+    if (!matchFrames.Acquire()) return false;
+    const MatchFrame& f = matchFrames.Front();
+    if (f.hits != soundedHits) PlaySound(hitSound);
+    if (f.goals != soundedGoals) PlaySound(scoreSound);
+    soundedHits = f.hits;
+    soundedGoals = f.goals;
+    return f.score[0] >= WIN_SCORE || f.score[1] >= WIN_SCORE;
+}
+
+// Between the last two steps, by the time since the newest
+static void DrawMatch(int w, int h) {
+    const MatchFrame& f = matchFrames.Front();
+    float alpha = fminf(1.0f, fmaxf(0.0f, (float)((SimThread::Now() - f.time) / PONG_STEP)));
+    DrawCircle(w/2, h/2, 150, GRAY);
+    DrawLine(w/2, 0, w/2, h, WHITE);
+    DrawCircleV({ f.prevBall.x + (f.ball.x - f.prevBall.x)*alpha, f.prevBall.y + (f.ball.y - f.prevBall.y)*alpha }, ball.radius, RED);
+    const Paddle* paddles[2] = { &player1, &player2 };
+    for (int p = 0; p < 2; p++) {
+        float y = f.prevPaddleY[p] + (f.paddleY[p] - f.prevPaddleY[p])*alpha;
+        DrawRectangleRounded({paddles[p]->x, y, paddles[p]->width, paddles[p]->height}, 0.8f, 0, WHITE);
+    }
+    DrawText(TextFormat("%i", f.score[1]), w/4 - 20, 20, 80, WHITE);
+    DrawText(TextFormat("%i", f.score[0]), 3*w/4 - 20, 20, 80, WHITE);
 }
 
 bool InitPong() {
@@ -93,47 +215,150 @@ bool InitPong() {
     state = PongState::Title;
     // load audio
     InitAudioDevice();
-    hitSound = LoadSound("data/pong/SE/tap.mp3");
-    scoreSound = LoadSound("data/pong/SE/score.mp3");
+    hitSound = Assets().LoadSound("data/pong/SE/tap.mp3");
+    scoreSound = Assets().LoadSound("data/pong/SE/score.mp3");
+    hitPool.Load("data/pong/SE/tap.mp3", 4);
+    scorePool.Load("data/pong/SE/score.mp3", 4);
     // init entities
     int w = GetScreenWidth(), h = GetScreenHeight();
     ball.Init(w,h);
     player1.Init(w,h,true);
     player2.Init(w,h,false);
     countdownStart = 0;
+    accumulator = 0;
+    chaos = false;
     return true;
 }
 
+// Chaos mode: the player still has the right paddle, the AI follows
+// whichever ball will reach the left first, and play never ends.
+static void UpdateChaosPong(float dt, int w, int h) {
+    if (Session().KeyPressed(KEY_RIGHT) && chaosBalls < CHAOS_MAX_BALLS) { chaosBalls *= 2; swarm.Resize(chaosBalls); }
+    if (Session().KeyPressed(KEY_LEFT) && chaosBalls > CHAOS_MIN_BALLS) { chaosBalls /= 2; swarm.Resize(chaosBalls); }
+    accumulator += fminf(dt, MAX_FRAME_TIME);
+    while (accumulator >= PONG_STEP) {
+        accumulator -= PONG_STEP;
+        int target = swarm.Urgent(1);
+        PongBody chased = target >= 0 ? swarm.Ball(target) : PongBody{{w/2.0f, h/2.0f}, {0, 0}, 0, 0};
+        player1.Update(PONG_STEP,h, chased, HeldKeys());
+        player2.Update(PONG_STEP,h, chased, 0);
+        PongPaddleBox paddles[2] = { player1.Box(), player2.Box() };
+        auto start = std::chrono::steady_clock::now();
+        swarm.Step(paddles, 2, PONG_STEP);
+        chaosStepMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        chaosBallSteps += swarm.Count();
+        hitPool.Trigger(swarm.WallHits() + swarm.PaddleHits());
+        scorePool.Trigger(swarm.Goals(0) + swarm.Goals(1));
+        // same sides as the single ball
+        player1Score += swarm.Goals(0);
+        player2Score += swarm.Goals(1);
+    }
+    hitPool.Flush();
+    scorePool.Flush();
+    if (Session().Time() - chaosRateAt >= 0.5 && chaosStepMs > 0) {
+        chaosBallsPerMs = (float)(chaosBallSteps / chaosStepMs);
+        chaosStepMs = 0;
+        chaosBallSteps = 0;
+        chaosRateAt = Session().Time();
+    }
+}
+
+static void DrawChaosPong(int w, int h, float alpha) {
+    DrawCircle(w/2, h/2, 150, GRAY);
+    DrawLine(w/2, 0, w/2, h, WHITE);
+    swarm.Draw(alpha); player1.Draw(alpha); player2.Draw(alpha);
+    DrawText(TextFormat("%i", player2Score), w/4 - 20, 20, 80, WHITE);
+    DrawText(TextFormat("%i", player1Score), 3*w/4 - 20, 20, 80, WHITE);
+    DrawText(TextFormat("%i balls  %.0f balls/ms  %i near a wall or paddle  LEFT/RIGHT: fewer/more balls",
+             swarm.Count(), chaosBallsPerMs, swarm.NarrowTests()), 10, h - 30, 20, GRAY);
+}
+
+// Network play: one session tick per fixed step; scores come from the
+// shared state, so both screens agree once rollbacks settle.
+static void UpdateNetPong(float dt) {
+    accumulator += fminf(dt, MAX_FRAME_TIME);
+    while (accumulator >= PONG_STEP) {
+        accumulator -= PONG_STEP;
+        int events = net.Tick(HeldKeys());
+        if (events & (PONG_HIT_WALL | PONG_HIT_PADDLE)) PlaySound(hitSound);
+        if (events & (PONG_GOAL_LEFT | PONG_GOAL_RIGHT)) PlaySound(scoreSound);
+    }
+    const PongNetState& s = net.State();
+    player1Score = s.score[0];
+    player2Score = s.score[1];
+    // only end on a result no late input can undo
+    if (PongNetOver(net.ConfirmedState())) state = PongState::GameOver;
+}
+
+static void DrawNetPong(int w, int h) {
+    const PongNetState& s = net.State();
+    if (!net.Connected()) {
+        DrawText(TextFormat("Waiting for player %i on port %i...", 2 - netConfig.player, netConfig.localPort), w/2 - 280, h/2 - 20, 30, WHITE);
+        return;
+    }
+    DrawCircle(w/2, h/2, 150, GRAY);
+    DrawLine(w/2, 0, w/2, h, WHITE);
+    DrawCircleV(s.ball.position, s.ball.radius, RED);
+    for (int p = 0; p < 2; p++) {
+        PongPaddleBox b = PongNetPaddle(s, p);
+        DrawRectangleRounded({b.x, b.y, b.width, b.height}, 0.8f, 0, p == net.LocalPlayer() ? WHITE : LIGHTGRAY);
+    }
+    DrawText(TextFormat("%i", s.score[1]), w/4 - 20, 20, 80, WHITE);
+    DrawText(TextFormat("%i", s.score[0]), 3*w/4 - 20, 20, 80, WHITE);
+    if (s.frame < PONG_SERVE_FRAMES)
+        DrawText(TextFormat("%i", 3 - (int)(s.frame * PONG_STEP)), w/2 - 20, h/2 - 40, 80, WHITE);
+    DrawText(TextFormat("Player %i  RTT %.0f ms  rollbacks %i (longest %i, %i frames)  predicted %i  stalls %i",
+             net.LocalPlayer() + 1, net.RttMs(), net.Rollbacks(), net.LongestRollback(), net.Resimulated(),
+             net.PredictedFrames(), net.Stalls()), 10, h - 30, 20, GRAY);
+}
+
 void UpdatePong() {
-    float dt = GetFrameTime();
+    float dt = Session().FrameTime();
     int w = GetScreenWidth(), h = GetScreenHeight();
     // global back to menu
-    if (IsKeyPressed(KEY_BACKSPACE) && state != PongState::Title) {
+    if (Session().KeyPressed(KEY_BACKSPACE) && state != PongState::Title) {
         state = PongState::Title;
+        matchThread.Stop();
+        net.Stop();
+        chaos = false;
         player1Score = player2Score = 0;
         ball.Reset(w,h);
     }
     switch (state) {
         case PongState::Title:
-            if (IsKeyPressed(KEY_ENTER)) { state = PongState::Countdown; countdownStart = GetTime(); }
+            if (Session().KeyPressed(KEY_ENTER) && netConfig.enabled) {
+                // the countdown is part of the shared simulation
+                netConfig.failed = !net.Start(netConfig.localPort, netConfig.host.c_str(), netConfig.remotePort,
+                                              netConfig.player, (float)w, (float)h, WIN_SCORE);
+                if (!netConfig.failed) {
+                    net.SetConditions(netConfig.lagMs, netConfig.jitterMs, netConfig.lossPercent);
+                    state = PongState::Playing; accumulator = 0;
+                }
+            } else if (Session().KeyPressed(KEY_ENTER)) { state = PongState::Countdown; countdownStart = Session().Time(); }
+            else if (Session().KeyPressed(KEY_C)) {
+                chaos = true;
+                swarm.Init(chaosBalls, (float)w, (float)h, (uint64_t)Session().Random(1, 1 << 30));
+                chaosStepMs = 0; chaosBallSteps = 0; chaosRateAt = Session().Time();
+                state = PongState::Countdown; countdownStart = Session().Time();
+            }
             break;
         case PongState::Countdown: {
-            if (GetTime() - countdownStart >= 3.0) state = PongState::Playing;
+            if (Session().Time() - countdownStart >= 3.0) {
+                state = PongState::Playing; accumulator = 0;
+                if (!chaos && !net.Active()) StartMatch();
+            }
             break;
         }
         case PongState::Playing:
-            ball.Update(dt,w,h);
-            player1.Update(dt,h, ball.position.y);
-            player2.Update(dt,h, ball.position.y);
-            if (CheckCollisionCircleRec(ball.position, ball.radius, player1.Rect()))
-                ball.Collide(player1.Rect());
-            if (CheckCollisionCircleRec(ball.position, ball.radius, player2.Rect()))
-                ball.Collide(player2.Rect());
-            if (player1Score >= WIN_SCORE || player2Score >= WIN_SCORE)
-                state = PongState::GameOver;
+            if (net.Active()) { UpdateNetPong(dt); break; }
+            if (chaos) { UpdateChaosPong(dt, w, h); break; }
+            if (FollowMatch()) { matchThread.Stop(); state = PongState::GameOver; }
             break;
         case PongState::GameOver:
-            if (IsKeyPressed(KEY_R)) {
+            // keep answering the peer so it can confirm the last frames
+            if (net.Active()) net.Tick(0);
+            if (Session().KeyPressed(KEY_R)) {
+                net.Stop();
                 player1Score = player2Score = 0;
                 ball.Reset(w,h);
                 state = PongState::Title;
@@ -146,7 +371,6 @@ void DrawPong() {
     int w = GetScreenWidth(), h = GetScreenHeight();
     // draw background and UI
     ClearBackground(BLACK);
-    BeginDrawing();
     switch (state) {
         case PongState::Title:
             DrawText("PONG PONG", w/2 - 170, h/2 - 80, 60, YELLOW);
@@ -154,19 +378,23 @@ void DrawPong() {
             DrawText("Controls:", w/2 - 200, h/2 + 40, 30, WHITE);
             DrawText("- UP/DOWN to move", w/2 - 200, h/2 + 80, 20, WHITE);
             DrawText("- BACKSPACE to main menu", w/2 - 200, h/2 + 110, 20, WHITE);
+            DrawText("- C for multi-ball chaos", w/2 - 200, h/2 + 140, 20, WHITE);
+            if (netConfig.enabled)
+                DrawText(TextFormat("Network play as Player %i with %s:%i%s", netConfig.player + 1, netConfig.host.c_str(),
+                         netConfig.remotePort, netConfig.failed ? " - could not open socket" : ""), w/2 - 200, h/2 + 180, 20, YELLOW);
             break;
         case PongState::Countdown: {
-            int cnt = 3 - (int)(GetTime() - countdownStart);
+            int cnt = 3 - (int)(Session().Time() - countdownStart);
             DrawText(TextFormat("%i", cnt), w/2 - 20, h/2 - 40, 80, WHITE);
             break;
         }
-        case PongState::Playing:
-            DrawCircle(w/2, h/2, 150, GRAY);
-            DrawLine(w/2, 0, w/2, h, WHITE);
-            ball.Draw(); player1.Draw(); player2.Draw();
-            DrawText(TextFormat("%i", player2Score), w/4 - 20, 20, 80, WHITE);
-            DrawText(TextFormat("%i", player1Score), 3*w/4 - 20, 20, 80, WHITE);
+        case PongState::Playing: {
+            if (net.Active()) { DrawNetPong(w, h); break; }
+            // draw between the last two steps to hide the fixed-step judder
+            if (chaos) { DrawChaosPong(w, h, accumulator / PONG_STEP); break; }
+            DrawMatch(w, h);
             break;
+        }
         case PongState::GameOver:
             DrawText(TextFormat("%s Wins!", (player1Score>player2Score)?"Player 1":"Player 2"),
                      w/2 - 200, h/2 - 60, 60, YELLOW);
@@ -174,11 +402,51 @@ void DrawPong() {
             DrawText("BACKSPACE for Menu", w/2 - 180, h/2 + 60, 20, WHITE);
             break;
     }
-    EndDrawing();
+}
+
+void SetPongNetplay(int localPort, const char* host, int remotePort, int player) {
+    netConfig.enabled = true;
+    netConfig.localPort = localPort;
+    netConfig.host = host;
+    netConfig.remotePort = remotePort;
+    netConfig.player = player == 2 ? 1 : 0;
+}
+
+void SetPongNetConditions(int lagMs, int jitterMs, float lossPercent) {
+    netConfig.lagMs = lagMs;
+    netConfig.jitterMs = jitterMs;
+    netConfig.lossPercent = lossPercent;
+}
+
+void SetPongAiParams(float speed, float deadZone, int reaction, float lead, float aim) {
+    aiParams.speed = speed;
+    aiParams.deadZone = deadZone;
+    aiParams.reaction = reaction;
+    aiParams.lead = lead;
+    aiParams.aim = aim;
+}
+
+bool SuspendPong(bool suspended) {
+    // online play keeps ticking so the peer is not left waiting
+    if (net.Active()) return false;
+    bool local = state == PongState::Playing && !chaos;
+    if (suspended) {
+        suspendedAt = Session().Time();
+        if (local) matchThread.Stop();
+    } else if (suspendedAt >= 0) {
+        countdownStart += Session().Time() - suspendedAt;
+        suspendedAt = -1;
+        if (local) matchThread.Start(PONG_STEP, StepMatch);
+    }
+    return true;
 }
 
 void UnloadPong() {
+    matchThread.Stop();
+    net.Stop();
     UnloadSound(hitSound);
     UnloadSound(scoreSound);
+    hitPool.Unload();
+    scorePool.Unload();
     CloseAudioDevice();
 }
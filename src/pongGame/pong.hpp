@@ -4,4 +4,22 @@
 bool InitPong();
 void UpdatePong();
 void DrawPong();
-void UnloadPong();
\ No newline at end of file
+void UnloadPong();
+// Pauses local play while the window is in the background; see GameModule.
+bool SuspendPong(bool suspended);
+// Two-player over UDP: player is 1 (right paddle) or 2 (left paddle).
+void SetPongNetplay(int localPort, const char* host, int remotePort, int player);
+// Loopback testing: extra one-way delay, random jitter and packet loss.
+void SetPongNetConditions(int lagMs, int jitterMs, float lossPercent);
+// Single-player AI strength; see PongAiParams. Defaults match the original.
+void SetPongAiParams(float speed, float deadZone, int reaction, float lead, float aim);
+// Headless AI-vs-AI matches over a grid of AI settings, spread across cores.
+// Prints win rate, rally length and CPU time per match for each setting.
+int RunPongSelfPlay(int matchesPerSet);
+// Steps the multi-ball swarm headless at growing ball counts and prints
+// balls updated per millisecond.
+int RunPongChaosBench(int maxBalls);
+// Plays two netplay sessions against each other over loopback, in real time
+// with some lag, cutting one direction off for bursts of growing length.
+// Fails if a session stalls for good or the two disagree on a confirmed frame.
+int RunPongNetBurst(int basePort);
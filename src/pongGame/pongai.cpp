@@ -0,0 +1,45 @@
+#include "pongai.hpp"
+#include <cmath>
+
+// Where the ball centre will be when it reaches x, bouncing off the walls.
+static float CrossingY(const PongBody& ball, float x, float fieldH) {
+    float t = (x - ball.position.x) / ball.velocity.x;
+    float y = ball.position.y + ball.velocity.y * t;
+    // fold the straight line back into the band the centre can reach
+    float lo = ball.radius, span = fieldH - 2.0f * ball.radius;
+    if (span <= 0.0f) return fieldH / 2.0f;
+    float u = fmodf(y - lo, 2.0f * span);
+    if (u < 0.0f) u += 2.0f * span;
+    return lo + (u <= span ? u : 2.0f * span - u);
+}
+
+int PongAiDecide(const PongAiParams& params, PongAiMemory& memory, const PongPaddleBox& paddle,
+                 const PongBody& ball, float fieldH) {
+    float center = paddle.y + paddle.height / 2.0f;
+    bool left = paddle.x < ball.position.x;
+    bool approaching = left ? ball.velocity.x < 0.0f : ball.velocity.x > 0.0f;
+    float target = ball.position.y;
+    if (params.lead > 0.0f) {
+        float face = left ? paddle.x + paddle.width + ball.radius : paddle.x - ball.radius;
+        float aim = approaching ? CrossingY(ball, face, fieldH) : fieldH / 2.0f;
+        target += (aim - target) * params.lead;
+    }
+    if (params.aim > 0.0f) {
+        // meet it off centre, on the side that sends it toward the nearer wall
+        float offset = params.aim * paddle.height / 2.0f;
+        target += target < fieldH / 2.0f ? offset : -offset;
+    }
+
+    // react to what was seen `reaction` frames ago
+    int reaction = params.reaction < PongAiMemory::HISTORY ? params.reaction : PongAiMemory::HISTORY - 1;
+    memory.targets[memory.frames % PongAiMemory::HISTORY] = target;
+    memory.frames++;
+    if (reaction > 0) {
+        int back = memory.frames - 1 - reaction;
+        target = back >= 0 ? memory.targets[back % PongAiMemory::HISTORY] : center;
+    }
+
+    float diff = target - center;
+    if (params.deadZone > 0.0f && fabsf(diff) <= params.deadZone) return 0;
+    return diff > 0.0f ? 1 : -1;
+}
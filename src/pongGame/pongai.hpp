@@ -0,0 +1,24 @@
+#pragma once
+#include "pongphysics.hpp"
+
+// Paddle AI. The defaults reproduce the original behaviour, which moves
+// toward the ball's current y at full speed every frame. The other knobs
+// make it weaker or stronger; the self-play tuner measures them.
+struct PongAiParams {
+    float speed = 1.0f;       // fraction of the paddle speed
+    float deadZone = 0.0f;    // px from the target where it stops moving
+    int reaction = 0;         // frames between seeing the ball and acting on it
+    float lead = 0.0f;        // 0 chases the ball, 1 heads for where it will cross
+    float aim = 0.0f;         // 0 meets the ball with the paddle centre, 1 with its end, for a steeper return
+};
+
+// What the AI remembers between frames.
+struct PongAiMemory {
+    static const int HISTORY = 32;
+    float targets[HISTORY];
+    int frames = 0;
+};
+
+// Direction to move this frame: -1 up, 1 down, 0 stay.
+int PongAiDecide(const PongAiParams& params, PongAiMemory& memory, const PongPaddleBox& paddle,
+                 const PongBody& ball, float fieldH);
@@ -0,0 +1,42 @@
+#include "pong.hpp"
+#include "../gamemodule.hpp"
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+
+static int PongCommand(int argc, char** argv, int* i) {
+    const char* arg = argv[*i];
+    if (strcmp(arg, "--pong-net") == 0 && *i + 3 < argc) {
+        // --pong-net LOCALPORT HOST:PORT PLAYER
+        int localPort = atoi(argv[++*i]);
+        std::string remote = argv[++*i];
+        int player = atoi(argv[++*i]);
+        size_t colon = remote.rfind(':');
+        if (colon != std::string::npos)
+            SetPongNetplay(localPort, remote.substr(0, colon).c_str(), atoi(remote.c_str() + colon + 1), player);
+    } else if (strcmp(arg, "--net-sim") == 0 && *i + 3 < argc) {
+        // --net-sim LAG_MS JITTER_MS LOSS_PERCENT
+        int lag = atoi(argv[++*i]);
+        int jitter = atoi(argv[++*i]);
+        SetPongNetConditions(lag, jitter, (float)atof(argv[++*i]));
+    } else if (strcmp(arg, "--pong-selfplay") == 0) {
+        return RunPongSelfPlay(OptionalCount(argc, argv, i, 200));
+    } else if (strcmp(arg, "--pong-chaos") == 0) {
+        return RunPongChaosBench(OptionalCount(argc, argv, i, 4096));
+    } else if (strcmp(arg, "--pong-net-burst") == 0) {
+        return RunPongNetBurst(OptionalCount(argc, argv, i, 47400));
+    } else if (strcmp(arg, "--pong-ai") == 0 && *i + 1 < argc) {
+        // --pong-ai SPEED,DEADZONE,REACTION,LEAD[,AIM]
+        float speed = 1, deadZone = 0, lead = 0, aim = 0;
+        int reaction = 0;
+        if (sscanf(argv[++*i], "%f,%f,%d,%f,%f", &speed, &deadZone, &reaction, &lead, &aim) >= 4)
+            SetPongAiParams(speed, deadZone, reaction, lead, aim);
+    }
+    return -1;
+}
+
+extern "C" const GameModule* ArcadeGetModule() {
+    static const GameModule module = {"Pong", InitPong, UpdatePong, DrawPong, UnloadPong, SuspendPong, PongCommand, nullptr};
+    return &module;
+}
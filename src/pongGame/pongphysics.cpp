@@ -0,0 +1,134 @@
+#include "pongphysics.hpp"
+#include <cmath>
+
+// Contacts resolved per step before the rest of the step is dropped; only a
+// ball wedged between a paddle and a wall gets anywhere near this.
+static const int MAX_CONTACTS = 16;
+
+namespace {
+    struct Contact {
+        float t;          // time of impact within the remaining step
+        Vector2 normal;   // surface normal at the contact, out of the surface
+        int kind;         // PongEvent of the surface
+        int paddle;       // paddle index when kind is PONG_HIT_PADDLE
+    };
+
+    void Consider(Contact& best, float t, Vector2 n, int kind, int paddle) {
+        if (t >= 0.0f && t < best.t) best = {t, n, kind, paddle};
+    }
+
+    // Earliest time the moving centre p + v*t enters the box grown by r,
+    // i.e. the circle touches the box. Faces first, then the corner arcs.
+    void SweepBox(Contact& best, Vector2 p, Vector2 v, float r, const PongPaddleBox& b, int paddle) {
+        float left = b.x - r, right = b.x + b.width + r;
+        float top = b.y - r, bottom = b.y + b.height + r;
+        if (v.x > 0.0f) {
+            float t = (left - p.x) / v.x, y = p.y + v.y * t;
+            if (y >= b.y && y <= b.y + b.height) Consider(best, t, {-1, 0}, PONG_HIT_PADDLE, paddle);
+        } else if (v.x < 0.0f) {
+            float t = (right - p.x) / v.x, y = p.y + v.y * t;
+            if (y >= b.y && y <= b.y + b.height) Consider(best, t, {1, 0}, PONG_HIT_PADDLE, paddle);
+        }
+        if (v.y > 0.0f) {
+            float t = (top - p.y) / v.y, x = p.x + v.x * t;
+            if (x >= b.x && x <= b.x + b.width) Consider(best, t, {0, -1}, PONG_HIT_PADDLE, paddle);
+        } else if (v.y < 0.0f) {
+            float t = (bottom - p.y) / v.y, x = p.x + v.x * t;
+            if (x >= b.x && x <= b.x + b.width) Consider(best, t, {0, 1}, PONG_HIT_PADDLE, paddle);
+        }
+        const Vector2 corners[4] = {{b.x, b.y}, {b.x + b.width, b.y},
+                                    {b.x, b.y + b.height}, {b.x + b.width, b.y + b.height}};
+        float a = v.x * v.x + v.y * v.y;
+        if (a <= 0.0f) return;
+        for (const Vector2& c : corners) {
+            Vector2 d = {p.x - c.x, p.y - c.y};
+            float half_b = d.x * v.x + d.y * v.y;
+            if (half_b >= 0.0f) continue; // moving away from this corner
+            float disc = half_b * half_b - a * (d.x * d.x + d.y * d.y - r * r);
+            if (disc < 0.0f) continue;
+            float t = (-half_b - sqrtf(disc)) / a;
+            Vector2 hit = {p.x + v.x * t - c.x, p.y + v.y * t - c.y};
+            Consider(best, t, {hit.x / r, hit.y / r}, PONG_HIT_PADDLE, paddle);
+        }
+    }
+
+    // The original paddle rule: the exit angle follows where on the paddle
+    // the ball lands, up to 45 degrees, and every hit speeds the ball up.
+    void BounceOffPaddle(PongBody& ball, const PongPaddleBox& b, Vector2 n) {
+        if (fabsf(n.x) >= fabsf(n.y)) {
+            float center = b.y + b.height / 2.0f;
+            float diff = (ball.position.y - center) / (b.height / 2.0f);
+            diff = diff < -1.0f ? -1.0f : (diff > 1.0f ? 1.0f : diff);
+            float angle = diff * 45.0f * DEG2RAD;
+            float dir = n.x < 0.0f ? -1.0f : 1.0f;
+            ball.velocity = {dir * cosf(angle), sinf(angle)};
+            ball.speed *= PONG_SPEEDUP;
+        } else {
+            // glancing off the paddle's end: plain reflection
+            float dot = ball.velocity.x * n.x + ball.velocity.y * n.y;
+            ball.velocity.x -= 2.0f * dot * n.x;
+            ball.velocity.y -= 2.0f * dot * n.y;
+        }
+    }
+
+    // A paddle that moved into the ball pushes it back out to the surface.
+    int Depenetrate(PongBody& ball, const PongPaddleBox& b) {
+        float qx = fmaxf(b.x, fminf(ball.position.x, b.x + b.width));
+        float qy = fmaxf(b.y, fminf(ball.position.y, b.y + b.height));
+        float dx = ball.position.x - qx, dy = ball.position.y - qy;
+        float d2 = dx * dx + dy * dy;
+        if (d2 >= ball.radius * ball.radius) return 0;
+        Vector2 n;
+        if (d2 > 1e-6f) {
+            float d = sqrtf(d2);
+            n = {dx / d, dy / d};
+        } else {
+            // centre inside the box: leave through the nearer side face
+            n = {ball.position.x < b.x + b.width / 2.0f ? -1.0f : 1.0f, 0.0f};
+            qx = n.x < 0 ? b.x : b.x + b.width;
+            qy = ball.position.y;
+        }
+        ball.position = {qx + n.x * ball.radius, qy + n.y * ball.radius};
+        if (ball.velocity.x * n.x + ball.velocity.y * n.y < 0.0f) {
+            BounceOffPaddle(ball, b, n);
+            return PONG_HIT_PADDLE;
+        }
+        return 0;
+    }
+}
+
+int PongStepBall(PongBody& ball, const PongPaddleBox* paddles, int paddleCount,
+                 float fieldW, float fieldH, float dt) {
+    int events = 0;
+    for (int i = 0; i < paddleCount; i++) events |= Depenetrate(ball, paddles[i]);
+
+    float remaining = dt;
+    for (int n = 0; n < MAX_CONTACTS && remaining > 0.0f; n++) {
+        Vector2 p = ball.position;
+        Vector2 v = {ball.velocity.x * ball.speed, ball.velocity.y * ball.speed};
+        float r = ball.radius;
+
+        Contact best = {remaining, {0, 0}, 0, -1};
+        if (v.y < 0.0f) Consider(best, fmaxf(0.0f, (r - p.y) / v.y), {0, 1}, PONG_HIT_WALL, -1);
+        if (v.y > 0.0f) Consider(best, fmaxf(0.0f, (fieldH - r - p.y) / v.y), {0, -1}, PONG_HIT_WALL, -1);
+        if (v.x < 0.0f) Consider(best, fmaxf(0.0f, (r - p.x) / v.x), {1, 0}, PONG_GOAL_LEFT, -1);
+        if (v.x > 0.0f) Consider(best, fmaxf(0.0f, (fieldW - r - p.x) / v.x), {-1, 0}, PONG_GOAL_RIGHT, -1);
+        for (int i = 0; i < paddleCount; i++) SweepBox(best, p, v, r, paddles[i], i);
+
+        ball.position = {p.x + v.x * best.t, p.y + v.y * best.t};
+        remaining -= best.t;
+        if (best.kind == 0) break;
+        events |= best.kind;
+        switch (best.kind) {
+            case PONG_HIT_WALL:
+                ball.velocity.y = best.normal.y * fabsf(ball.velocity.y);
+                break;
+            case PONG_HIT_PADDLE:
+                BounceOffPaddle(ball, paddles[best.paddle], best.normal);
+                break;
+            default: // a goal ends the rally
+                return events;
+        }
+    }
+    return events;
+}
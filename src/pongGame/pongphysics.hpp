@@ -0,0 +1,38 @@
+#pragma once
+#include "raylib.h"
+
+// Ball physics for Pong, free of input and audio so it can run at a fixed
+// step anywhere. The ball is moved by swept-circle time of impact: every
+// contact inside a step is found in time order and resolved where it
+// happens, so nothing tunnels however fast the ball is or however long the
+// step.
+
+// 120 Hz physics; frames run as many steps as they need.
+static const float PONG_STEP = 1.0f / 120.0f;
+
+struct PongBody {
+    Vector2 position;
+    Vector2 velocity;   // unit direction
+    float speed;
+    float radius;
+};
+
+struct PongPaddleBox {
+    float x, y, width, height;
+};
+
+// Step events, combined as bit flags
+enum PongEvent {
+    PONG_HIT_WALL   = 1,
+    PONG_HIT_PADDLE = 2,
+    PONG_GOAL_LEFT  = 4,  // ball left through x = 0
+    PONG_GOAL_RIGHT = 8,  // ball left through x = fieldW
+};
+
+// Bounce speed-up per paddle hit, as in the original rules.
+static const float PONG_SPEEDUP = 1.05f;
+
+// Advances the ball by dt against the field walls and the paddles. Stops
+// at a goal, leaving the ball touching the goal line. Returns PongEvent flags.
+int PongStepBall(PongBody& ball, const PongPaddleBox* paddles, int paddleCount,
+                 float fieldW, float fieldH, float dt);
@@ -0,0 +1,138 @@
+#include "pong.hpp"
+#include "netplay.hpp"
+#include "pongai.hpp"
+#include "../common/jobs.hpp"
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <ctime>
+
+// Self-play runs the deterministic network step, so a match is fixed by its
+// seed and the loop makes no raylib calls. Each seed is played once from
+// each side, against the default AI.
+//
+// Two AIs that both meet the ball dead centre return it flat forever, so a
+// rally that runs too long is called a stalemate and served again; a match
+// with too many stalemates is a draw.
+
+namespace {
+    const int POINTS_TO_WIN = 6;
+    const int RALLY_FRAMES = (int)(60.0f / PONG_STEP);
+    const int MAX_STALEMATES = 3;
+    const float FIELD_W = 1200.0f;
+    const float FIELD_H = 800.0f;
+
+    struct MatchResult {
+        int outcome;        // 1 candidate won, -1 reference won, 0 draw
+        int points;
+        int stalemates;
+        int paddleHits;
+        int frames;
+        double cpuUs;
+    };
+
+    double ThreadCpuUs() {
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+    }
+
+    uint32_t MatchSeed(int match) {
+        uint32_t x = (uint32_t)match * 2654435761u + 0x9E3779B9u;
+        return x ? x : 1;
+    }
+
+    // candidate plays paddle `side` (0 right, 1 left); the reference the other
+    MatchResult PlayMatch(const PongAiParams& candidate, const PongAiParams& reference, int side, uint32_t seed) {
+        double start = ThreadCpuUs();
+        PongNetState s;
+        PongNetInit(s, seed, FIELD_W, FIELD_H, INT_MAX);
+        s.frame = PONG_SERVE_FRAMES; // no countdown
+        const PongAiParams* params[2] = {side == 0 ? &candidate : &reference, side == 0 ? &reference : &candidate};
+        s.paddleSpeed[0] = params[0]->speed;
+        s.paddleSpeed[1] = params[1]->speed;
+        PongAiMemory memory[2];
+
+        int won[2] = {0, 0};
+        MatchResult r = {0, 0, 0, 0, 0, 0};
+        int rally = 0;
+        while (won[0] < POINTS_TO_WIN && won[1] < POINTS_TO_WIN && r.stalemates < MAX_STALEMATES) {
+            uint8_t inputs[2];
+            for (int p = 0; p < 2; p++) {
+                int dir = PongAiDecide(*params[p], memory[p], PongNetPaddle(s, p), s.ball, s.fieldH);
+                inputs[p] = dir < 0 ? PONG_IN_UP : (dir > 0 ? PONG_IN_DOWN : 0);
+            }
+            int events = PongNetStep(s, inputs[0], inputs[1]);
+            r.frames++;
+            rally++;
+            if (events & PONG_HIT_PADDLE) r.paddleHits++;
+            // the point goes to whoever the ball got away from
+            if (events & PONG_GOAL_LEFT) won[0]++;
+            if (events & PONG_GOAL_RIGHT) won[1]++;
+            if (events & (PONG_GOAL_LEFT | PONG_GOAL_RIGHT)) rally = 0;
+            else if (rally >= RALLY_FRAMES) { r.stalemates++; rally = 0; PongNetServe(s); }
+        }
+        r.outcome = won[side] >= POINTS_TO_WIN ? 1 : (won[1 - side] >= POINTS_TO_WIN ? -1 : 0);
+        r.points = won[0] + won[1];
+        r.cpuUs = ThreadCpuUs() - start;
+        return r;
+    }
+}
+
+int RunPongSelfPlay(int matchesPerSet) {
+    std::vector<PongAiParams> sets;
+    const float speeds[] = {0.6f, 0.8f, 1.0f};
+    const int reactions[] = {0, 8, 16};
+    const float leads[] = {0.0f, 0.5f, 1.0f};
+    const float aims[] = {0.0f, 0.5f, 1.0f};
+    for (float speed : speeds)
+        for (int reaction : reactions)
+            for (float lead : leads)
+                for (float aim : aims) {
+                    PongAiParams p;
+                    p.speed = speed;
+                    p.reaction = reaction;
+                    p.lead = lead;
+                    p.aim = aim;
+                    p.deadZone = lead > 0.0f ? 8.0f : 0.0f; // settles once it has a fixed aim
+                    sets.push_back(p);
+                }
+    const PongAiParams reference;
+    int matches = std::max(2, matchesPerSet & ~1);
+
+    JobSystem& jobs = Jobs();
+    printf("%d matches per set against the default AI, first to %d, %d threads\n", matches, POINTS_TO_WIN, jobs.Size());
+    printf("%6s %9s %5s %5s %5s | %7s %6s %11s %11s %13s %12s %10s\n",
+           "speed", "reaction", "lead", "aim", "dead", "win %", "draws", "stalemates", "hits/point", "frames/point", "cpu us/match", "matches/s");
+
+    std::vector<MatchResult> results(matches);
+    for (const PongAiParams& p : sets) {
+        auto play = [&](int begin, int end, int) {
+            for (int i = begin; i < end; i++) results[i] = PlayMatch(p, reference, i & 1, MatchSeed(i / 2));
+        };
+        auto start = std::chrono::steady_clock::now();
+        jobs.ParallelFor(matches, 8, play);
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        int wins = 0, draws = 0, stalemates = 0;
+        long long points = 0, hits = 0, frames = 0;
+        double cpu = 0;
+        for (const MatchResult& r : results) {
+            wins += r.outcome > 0;
+            draws += r.outcome == 0;
+            stalemates += r.stalemates;
+            points += r.points;
+            hits += r.paddleHits;
+            frames += r.frames;
+            cpu += r.cpuUs;
+        }
+        double perPoint = points ? 1.0 / points : 0.0;
+        printf("%6.2f %9d %5.2f %5.2f %5.1f | %6.1f%% %6d %11d %11.2f %13.1f %12.0f %10.0f\n",
+               p.speed, p.reaction, p.lead, p.aim, p.deadZone, 100.0 * wins / matches, draws, stalemates,
+               hits * perPoint, frames * perPoint, cpu / matches, matches / secs);
+    }
+    return 0;
+}
@@ -0,0 +1,280 @@
+#include "arena.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Food search gives up after this many cells; far food is found by wandering.
+static const int SEARCH_CELLS = 256;
+// Free cells a move must lead to, at most, to count as safe.
+static const int SPACE_CAP = 48;
+static const unsigned RESPAWN_TICKS = 20;
+
+void SnakeArena::Init(int width, int height, int snakes, int maxLength, int workers, uint64_t seed) {
+    cols = width;
+    rows = height;
+    maxLen = maxLength;
+    int n = cols * rows;
+    board.Resize(cols, rows);
+    tailOut.assign(n, 0);
+    food.assign(n, 0);
+    foodCells.clear();
+    foodCells.reserve(n);
+    foodSlot.assign(n, -1);
+    foodTarget = std::min(n / 8, snakes * 2 + 16);
+
+    segs.assign(snakes * maxLen, 0);
+    segStart.assign(snakes, 0);
+    segLen.assign(snakes, 0);
+    grow.assign(snakes, 0);
+    target.assign(snakes, -1);
+    alive.assign(snakes, 0);
+    dying.assign(snakes, 0);
+    respawnAt.assign(snakes, 0);
+    eaten.assign(snakes, 0);
+    claimTick.assign(n, 0);
+    claimBy.assign(n, -1);
+
+    scratch.resize(workers);
+    for (Scratch& s : scratch) {
+        s.seen.assign(n, 0);
+        s.parent.assign(n, -1);
+        s.queue.assign(n, 0);
+        s.stamp = 0;
+    }
+    rng = seed ? seed : 1;
+    tick = 0;
+    deaths = 0;
+    for (int i = 0; i < snakes; i++) Spawn(i);
+    while ((int)foodCells.size() < foodTarget) {
+        int c = RandomFreeCell();
+        if (c < 0) break;
+        PlaceFood(c);
+    }
+}
+
+// xorshift64*, so runs repeat for a given seed
+uint32_t SnakeArena::NextRandom() {
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return (uint32_t)((rng * 2685821657736338717ULL) >> 32);
+}
+
+// A cell with neither a snake nor food, or -1 after a few misses.
+int SnakeArena::RandomFreeCell() {
+    for (int tries = 0; tries < 8 && board.FreeCount() > 0; tries++) {
+        int c = board.FreeCellAt(NextRandom() % board.FreeCount());
+        if (!food[c]) return c;
+    }
+    return -1;
+}
+
+void SnakeArena::PlaceFood(int cell) {
+    if (food[cell]) return;
+    food[cell] = 1;
+    foodSlot[cell] = (int)foodCells.size();
+    foodCells.push_back(cell);
+}
+
+void SnakeArena::EatFood(int cell) {
+    int last = foodCells.back();
+    foodCells[foodSlot[cell]] = last;
+    foodSlot[last] = foodSlot[cell];
+    foodCells.pop_back();
+    foodSlot[cell] = -1;
+    food[cell] = 0;
+}
+
+// New snakes are a single head that grows out over the next ticks.
+bool SnakeArena::Spawn(int snake) {
+    int c = RandomFreeCell();
+    if (c < 0) return false;
+    segStart[snake] = 0;
+    segLen[snake] = 1;
+    Seg(snake, 0) = c;
+    grow[snake] = 2;
+    alive[snake] = 1;
+    board.Occupy(c);
+    return true;
+}
+
+// Frees the body and leaves food on every other segment.
+void SnakeArena::Kill(int snake) {
+    for (int i = 0; i < segLen[snake]; i++) {
+        int c = Seg(snake, i);
+        board.Release(c);
+        if (i % 2 == 0) PlaceFood(c);
+    }
+    segLen[snake] = 0;
+    alive[snake] = 0;
+    respawnAt[snake] = tick + RESPAWN_TICKS;
+    deaths++;
+}
+
+// Free cells reachable from `from`, counting no further than cap.
+int SnakeArena::Reachable(Scratch& s, int from, int cap) const {
+    uint32_t mark = ++s.stamp;
+    int qHead = 0, qTail = 0;
+    s.queue[qTail++] = from;
+    s.seen[from] = mark;
+    while (qHead < qTail && qTail < cap) {
+        int c = s.queue[qHead++];
+        int cx = c % cols, cy = c / cols;
+        int next[4] = {cy > 0 ? c - cols : -1, cy < rows - 1 ? c + cols : -1,
+                       cx > 0 ? c - 1 : -1,    cx < cols - 1 ? c + 1 : -1};
+        for (int n : next) {
+            if (n < 0 || s.seen[n] == mark || Blocked(n)) continue;
+            s.seen[n] = mark;
+            s.queue[qTail++] = n;
+        }
+    }
+    return std::min(qTail, cap);
+}
+
+// Heads for the nearest food found by a bounded BFS, unless that move leads
+// into a pocket too small for the body; then takes the roomiest move.
+void SnakeArena::Decide(int snake, Scratch& s) {
+    int head = HeadOf(snake);
+    int hx = head % cols, hy = head / cols;
+
+    int preferred = -1;
+    uint32_t mark = ++s.stamp;
+    int qHead = 0, qTail = 0;
+    s.queue[qTail++] = head;
+    s.seen[head] = mark;
+    s.parent[head] = -1;
+    while (qHead < qTail && qTail < SEARCH_CELLS && preferred < 0) {
+        int c = s.queue[qHead++];
+        int cx = c % cols, cy = c / cols;
+        int next[4] = {cy > 0 ? c - cols : -1, cy < rows - 1 ? c + cols : -1,
+                       cx > 0 ? c - 1 : -1,    cx < cols - 1 ? c + 1 : -1};
+        for (int n : next) {
+            if (n < 0 || s.seen[n] == mark || Blocked(n)) continue;
+            s.seen[n] = mark;
+            s.parent[n] = c;
+            if (food[n]) {
+                while (s.parent[n] != head) n = s.parent[n];
+                preferred = n;
+                break;
+            }
+            s.queue[qTail++] = n;
+        }
+    }
+
+    int need = std::min(segLen[snake] + grow[snake] + 2, SPACE_CAP);
+    int best = -1, bestSpace = 0;
+    const int offsets[4][2] = {{0,-1}, {0,1}, {-1,0}, {1,0}};
+    for (auto& o : offsets) {
+        int nx = hx + o[0], ny = hy + o[1];
+        if (nx < 0 || ny < 0 || nx >= cols || ny >= rows) continue;
+        int n = ny * cols + nx;
+        if (Blocked(n)) continue;
+        int space = Reachable(s, n, SPACE_CAP);
+        if (n == preferred && space >= need) { best = n; break; }
+        if (space > bestSpace) { bestSpace = space; best = n; }
+    }
+    target[snake] = best;
+}
+
+void SnakeArena::Step(JobSystem& jobs) {
+    tick++;
+    int n = Count();
+
+    // Tails of snakes that are not growing leave this tick, before anyone
+    // moves in, so Decide() may follow them
+    for (int i = 0; i < n; i++) {
+        if (alive[i] && grow[i] == 0) tailOut[Seg(i, 0)] = tick;
+    }
+    auto decide = [this](int begin, int end, int worker) {
+        Scratch& s = scratch[worker];
+        for (int i = begin; i < end; i++) {
+            if (alive[i]) Decide(i, s);
+        }
+    };
+    jobs.ParallelFor(n, 8, decide);
+
+    // Tails move out first, as Decide() counted on
+    for (int i = 0; i < n; i++) {
+        if (!alive[i]) continue;
+        if (grow[i] > 0) { grow[i]--; continue; }
+        board.Release(Seg(i, 0));
+        segStart[i] = (segStart[i] + 1) % maxLen;
+        segLen[i]--;
+    }
+    // Claims: a cell chosen by two snakes kills both
+    for (int i = 0; i < n; i++) {
+        int t = target[i];
+        if (!alive[i] || t < 0) continue;
+        if (claimTick[t] == tick) claimBy[t] = -1;
+        else { claimTick[t] = tick; claimBy[t] = i; }
+    }
+    for (int i = 0; i < n; i++) {
+        if (!alive[i]) { dying[i] = 0; continue; }
+        int t = target[i];
+        dying[i] = t < 0 || board.IsOccupied(t) || claimBy[t] != i;
+    }
+    // Survivors advance; the claims above guarantee distinct cells
+    for (int i = 0; i < n; i++) {
+        if (!alive[i] || dying[i]) continue;
+        int t = target[i];
+        Seg(i, segLen[i]) = t;
+        segLen[i]++;
+        board.Occupy(t);
+        if (food[t]) {
+            EatFood(t);
+            eaten[i]++;
+            if (segLen[i] + grow[i] < maxLen) grow[i]++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        if (dying[i]) Kill(i);
+    }
+    for (int i = 0; i < n; i++) {
+        if (!alive[i] && !dying[i] && tick >= respawnAt[i]) Spawn(i);
+    }
+    while ((int)foodCells.size() < foodTarget) {
+        int c = RandomFreeCell();
+        if (c < 0) break;
+        PlaceFood(c);
+    }
+}
+
+void SnakeArena::Draw(int offsetX, int offsetY, int cellSize) const {
+    for (int c : foodCells) {
+        DrawRectangle(offsetX + (c % cols) * cellSize, offsetY + (c / cols) * cellSize, cellSize, cellSize, RED);
+    }
+    for (int i = 0; i < Count(); i++) {
+        if (!alive[i]) continue;
+        Color col = ColorFromHSV(fmodf(i * 137.5f, 360.0f), 0.75f, 0.55f);
+        for (int k = 0; k < segLen[i]; k++) {
+            int c = segs[i * maxLen + (segStart[i] + k) % maxLen];
+            DrawRectangle(offsetX + (c % cols) * cellSize, offsetY + (c / cols) * cellSize, cellSize, cellSize, col);
+        }
+    }
+}
+
+int SnakeArena::Alive() const {
+    int count = 0;
+    for (uint8_t a : alive) count += a;
+    return count;
+}
+
+int SnakeArena::Longest() const {
+    int best = 0;
+    for (int i = 0; i < Count(); i++) best = std::max(best, segLen[i]);
+    return best;
+}
+
+uint64_t SnakeArena::Checksum() const {
+    uint64_t h = 1469598103934665603ULL; // FNV-1a
+    auto mix = [&h](uint64_t v) { h = (h ^ v) * 1099511628211ULL; };
+    for (int i = 0; i < Count(); i++) {
+        mix(alive[i]);
+        mix(segLen[i]);
+        if (segLen[i] > 0) mix(HeadOf(i));
+    }
+    for (int c = 0; c < cols * rows; c++) {
+        if (food[c]) mix(c);
+    }
+    mix(deaths);
+    return h;
+}
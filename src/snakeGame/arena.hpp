@@ -0,0 +1,82 @@
+#pragma once
+#include "raylib.h"
+#include "occupancy.hpp"
+#include "../common/jobs.hpp"
+#include <vector>
+#include <cstdint>
+
+// Many AI snakes on one shared board. Per-snake state is kept as parallel
+// arrays, indexed by snake. Each tick runs in two phases:
+//  - decide: every snake picks its next cell in parallel. Snakes only read
+//    the shared board and write their own slot, using per-worker search
+//    buffers.
+//  - resolve: moves are applied serially in snake order. Snakes that pick
+//    the same cell both die, so the outcome never depends on thread timing.
+class SnakeArena {
+    private:
+        // per-worker search buffers, reset by bumping the stamp
+        struct Scratch {
+            std::vector<uint32_t> seen;
+            std::vector<int> parent;
+            std::vector<int> queue;
+            uint32_t stamp;
+        };
+
+        int cols;
+        int rows;
+        int maxLen;
+        OccupancyGrid board;          // cells under any snake
+        std::vector<unsigned> tailOut; // tick a tail leaves the cell, so it can be entered
+        std::vector<uint8_t> food;    // 1 where food lies
+        std::vector<int> foodCells;   // where food lies, in no order
+        std::vector<int> foodSlot;    // index in foodCells, per cell
+        int foodTarget;
+
+        // snakes, structure of arrays
+        std::vector<int> segs;        // maxLen ring slots per snake, cell indices
+        std::vector<int> segStart;    // ring slot of the tail
+        std::vector<int> segLen;
+        std::vector<int> grow;        // segments still to add
+        std::vector<int> target;      // cell chosen this tick, -1 for none
+        std::vector<uint8_t> alive;
+        std::vector<uint8_t> dying;
+        std::vector<unsigned> respawnAt;
+        std::vector<int> eaten;
+
+        // move resolution
+        std::vector<unsigned> claimTick;
+        std::vector<int> claimBy;     // -1 when two snakes claimed the cell
+
+        std::vector<Scratch> scratch;
+        uint64_t rng;
+        unsigned tick;
+        int deaths;
+
+        uint32_t NextRandom();
+        int& Seg(int snake, int i) {return segs[snake * maxLen + (segStart[snake] + i) % maxLen];}
+        int HeadOf(int snake) const {return segs[snake * maxLen + (segStart[snake] + segLen[snake] - 1) % maxLen];}
+        int RandomFreeCell();
+        void PlaceFood(int cell);
+        void EatFood(int cell);
+        bool Blocked(int cell) const {return board.IsOccupied(cell) && tailOut[cell] != tick;}
+        bool Spawn(int snake);
+        void Kill(int snake);
+        int Reachable(Scratch& s, int from, int cap) const;
+        void Decide(int snake, Scratch& s);
+
+    public:
+        SnakeArena()
+        : cols(0), rows(0), maxLen(0), foodTarget(0), rng(1), tick(0), deaths(0) {};
+        // Sizes every buffer once; workers is the Size() of the job system Step() gets.
+        void Init(int width, int height, int snakes, int maxLength, int workers, uint64_t seed);
+        void Step(JobSystem& jobs);
+        void Draw(int offsetX, int offsetY, int cellSize) const;
+
+        int Count() const {return (int)alive.size();}
+        int Alive() const;
+        int Longest() const;
+        int Deaths() const {return deaths;}
+        unsigned Ticks() const {return tick;}
+        // Hash of the board, snakes and food; equal runs give equal values.
+        uint64_t Checksum() const;
+};
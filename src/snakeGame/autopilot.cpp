@@ -0,0 +1,254 @@
+#include "autopilot.hpp"
+#include <algorithm>
+
+// Cells of cycle kept free between head and tail beyond the growth in hand,
+// so shortcuts leave room for the next few segments.
+static const int SHORTCUT_MARGIN = 3;
+
+void SnakeAutopilot::Reserve(int width, int height) {
+    cols = width;
+    rows = height;
+    int n = cols * rows;
+    seen.assign(n, 0);
+    blocked.assign(n, 0);
+    parent.assign(n, -1);
+    dist.assign(n, 0);
+    queue.assign(n, 0);
+    plan.clear();
+    plan.reserve(n);
+    stamp = 0;
+    BuildCycle();
+    Reset();
+}
+
+void SnakeAutopilot::Reset() {
+    plan.clear();
+    planPos = 0;
+    planFood = -1;
+    plansMade = 0;
+    planCells = 0;
+    orderChecked = false;
+}
+
+// Serpentine Hamiltonian cycle; needs an even number of rows or of columns.
+// Walked in reverse so odd rows run left to right, matching the start body.
+void SnakeAutopilot::BuildCycle() {
+    hasCycle = cols >= 2 && rows >= 2 && (rows % 2 == 0 || cols % 2 == 0);
+    cycleIdx.assign(cols * rows, 0);
+    cycleNext.assign(cols * rows, 0);
+    if (!hasCycle) return;
+
+    // (a, b) = (column, row) on a board whose row count B is even
+    bool transposed = rows % 2 != 0;
+    int A = transposed ? rows : cols;
+    int B = transposed ? cols : rows;
+    auto at = [&](int a, int b) { return transposed ? a * cols + b : b * cols + a; };
+
+    std::vector<int> order;
+    order.reserve(cols * rows);
+    for (int a = 0; a < A; a++) order.push_back(at(a, 0));
+    for (int b = 1; b < B; b++) {
+        if (b % 2) { for (int a = A - 1; a >= 1; a--) order.push_back(at(a, b)); }
+        else       { for (int a = 1; a < A; a++) order.push_back(at(a, b)); }
+    }
+    for (int b = B - 1; b >= 1; b--) order.push_back(at(0, b));
+    std::reverse(order.begin(), order.end());
+
+    int n = (int)order.size();
+    for (int i = 0; i < n; i++) {
+        cycleIdx[order[i]] = i;
+        cycleNext[order[i]] = order[(i + 1) % n];
+    }
+}
+
+// Steps forward along the cycle from one cell to another.
+int SnakeAutopilot::CycleDist(int from, int to) const {
+    int d = cycleIdx[to] - cycleIdx[from];
+    return d < 0 ? d + cols * rows : d;
+}
+
+// True when the segments wind forward round the cycle less than once.
+bool SnakeAutopilot::BodyFollowsCycle(const OccupancyGrid& board, const SnakeBody& body) const {
+    long long span = 0;
+    int prev = -1;
+    body.ForEach([&](uint32_t p) {
+        int c = board.Cell(SnakeBody::X(p), SnakeBody::Y(p));
+        if (prev >= 0) span += CycleDist(prev, c);
+        prev = c;
+    });
+    return span < cols * rows;
+}
+
+// Breadth-first search from `from`. Stops when `goal` is reached by a path of
+// at least minGoalDist steps; with goal -1 it floods the whole region so
+// dist/seen can be read afterwards.
+template <typename Passable>
+bool SnakeAutopilot::Bfs(int from, int goal, int minGoalDist, Passable&& passable) {
+    if (++stamp == 0) {
+        std::fill(seen.begin(), seen.end(), 0);
+        std::fill(blocked.begin(), blocked.end(), 0);
+        stamp = 1;
+    }
+    int qHead = 0, qTail = 0;
+    queue[qTail++] = from;
+    seen[from] = stamp;
+    dist[from] = 0;
+    parent[from] = -1;
+    while (qHead < qTail) {
+        int c = queue[qHead++];
+        int cx = c % cols, cy = c / cols;
+        int next[4] = {cy > 0 ? c - cols : -1, cy < rows - 1 ? c + cols : -1,
+                       cx > 0 ? c - 1 : -1,    cx < cols - 1 ? c + 1 : -1};
+        for (int n : next) {
+            if (n < 0 || seen[n] == stamp) continue;
+            if (n == goal) {
+                if (dist[c] + 1 < minGoalDist) continue;
+                seen[n] = stamp;
+                dist[n] = dist[c] + 1;
+                parent[n] = c;
+                return true;
+            }
+            if (!passable(n)) continue;
+            seen[n] = stamp;
+            dist[n] = dist[c] + 1;
+            parent[n] = c;
+            queue[qTail++] = n;
+        }
+    }
+    return false;
+}
+
+bool SnakeAutopilot::PlanToFood(const OccupancyGrid& board, const SnakeBody& body, int foodCell, bool growing) {
+    int head = board.Cell(SnakeBody::X(body.Head()), SnakeBody::Y(body.Head()));
+    int tail = board.Cell(SnakeBody::X(body.Tail()), SnakeBody::Y(body.Tail()));
+    bool found = Bfs(head, foodCell, 1, [&](int c) {
+        return !board.IsOccupied(c) || (c == tail && !growing);
+    });
+    plan.clear();
+    planPos = 0;
+    if (!found) return false;
+    for (int c = foodCell; c != head; c = parent[c]) plan.push_back(c);
+    std::reverse(plan.begin(), plan.end());
+    return true;
+}
+
+// Replays the plan on a virtual body and checks the tail is still reachable
+// from the food, by a route longer than one step since the snake will grow.
+bool SnakeAutopilot::PlanIsSafe(const OccupancyGrid& board, const SnakeBody& body, bool growing) {
+    int len = body.Length();
+    int steps = (int)plan.size();
+    int keep = std::min(len + steps, len + (growing ? 1 : 0));
+    if (keep + 1 >= cols * rows) return true; // eating this fills the board
+
+    uint32_t mark = ++stamp;
+    int skip = len + steps - keep;
+    int idx = 0;
+    int virtualTail = -1;
+    auto place = [&](int c) {
+        if (idx++ < skip) return;
+        blocked[c] = mark;
+        if (virtualTail < 0) virtualTail = c;
+    };
+    body.ForEach([&](uint32_t p) { place(board.Cell(SnakeBody::X(p), SnakeBody::Y(p))); });
+    for (int c : plan) place(c);
+
+    return Bfs(plan.back(), virtualTail, 2, [&](int c) { return blocked[c] != mark; });
+}
+
+// Step to the free neighbour farthest from the tail that can still reach it.
+int SnakeAutopilot::ChaseTail(const OccupancyGrid& board, const SnakeBody& body, bool growing) {
+    int hx = SnakeBody::X(body.Head()), hy = SnakeBody::Y(body.Head());
+    int tail = board.Cell(SnakeBody::X(body.Tail()), SnakeBody::Y(body.Tail()));
+    Bfs(tail, -1, 0, [&](int c) { return !board.IsOccupied(c); });
+
+    int best = -1, bestDist = -1, fallback = -1;
+    const int offsets[4][2] = {{0,-1}, {0,1}, {-1,0}, {1,0}};
+    for (auto& o : offsets) {
+        int nx = hx + o[0], ny = hy + o[1];
+        if (!board.InBounds(nx, ny)) continue;
+        int n = board.Cell(nx, ny);
+        bool enterable = !board.IsOccupied(n) || (n == tail && !growing);
+        if (!enterable) continue;
+        if (fallback < 0) fallback = n;
+        int d = (n == tail) ? 0 : (seen[n] == stamp ? dist[n] : -1);
+        if (d > bestDist) { bestDist = d; best = n; }
+    }
+    return best >= 0 ? best : fallback;
+}
+
+// The cached plan's next cell, if it still leads to this food from here.
+int SnakeAutopilot::NextPlanStep(const OccupancyGrid& board, int head, int tail, int foodCell, bool growing) {
+    if (foodCell < 0 || foodCell != planFood || planPos >= (int)plan.size()) return -1;
+    int c = plan[planPos];
+    int adx = c % cols - head % cols, ady = c / cols - head / cols;
+    bool adjacent = adx * adx + ady * ady == 1;
+    if (!adjacent || (board.IsOccupied(c) && !(c == tail && !growing))) return -1;
+    return c;
+}
+
+int SnakeAutopilot::DecideOnCycle(const OccupancyGrid& board, const SnakeBody& body, int foodCell, bool growing) {
+    int head = board.Cell(SnakeBody::X(body.Head()), SnakeBody::Y(body.Head()));
+    int tail = board.Cell(SnakeBody::X(body.Tail()), SnakeBody::Y(body.Tail()));
+    int next = -1;
+
+    // shortcuts only while the body is short enough to leave gaps safely
+    if (foodCell >= 0 && body.Length() < cols * rows / 2) {
+        int step = NextPlanStep(board, head, tail, foodCell, growing);
+        if (step < 0 && PlanToFood(board, body, foodCell, growing)) {
+            planFood = foodCell;
+            plansMade++;
+            planCells += (long long)plan.size();
+            step = plan[0];
+        }
+        if (step >= 0) {
+            int room = CycleDist(head, tail) - (growing ? 1 : 0) - SHORTCUT_MARGIN;
+            int jump = CycleDist(head, step);
+            // never overtake the tail, and never skip past the food
+            if (jump < room && jump <= CycleDist(head, foodCell)) {
+                next = step;
+                planPos++;
+            } else {
+                planFood = -1;
+            }
+        }
+    }
+    if (next < 0) {
+        int succ = cycleNext[head];
+        if (!board.IsOccupied(succ) || (succ == tail && !growing)) next = succ;
+    }
+    return next;
+}
+
+int SnakeAutopilot::DecideGreedy(const OccupancyGrid& board, const SnakeBody& body, int foodCell, bool growing) {
+    int head = board.Cell(SnakeBody::X(body.Head()), SnakeBody::Y(body.Head()));
+    int tail = board.Cell(SnakeBody::X(body.Tail()), SnakeBody::Y(body.Tail()));
+
+    // keep following a committed plan while it still leads to the same food
+    int next = NextPlanStep(board, head, tail, foodCell, growing);
+    if (next >= 0) {
+        planPos++;
+        return next;
+    }
+    planFood = -1;
+    if (foodCell >= 0 && PlanToFood(board, body, foodCell, growing) && PlanIsSafe(board, body, growing)) {
+        planFood = foodCell;
+        plansMade++;
+        planCells += (long long)plan.size();
+        return plan[planPos++];
+    }
+    return ChaseTail(board, body, growing);
+}
+
+bool SnakeAutopilot::Decide(const OccupancyGrid& board, const SnakeBody& body, int foodCell, bool growing, int& dx, int& dy) {
+    if (!orderChecked) {
+        bodyOnCycle = hasCycle && BodyFollowsCycle(board, body);
+        orderChecked = true;
+    }
+    int next = bodyOnCycle ? DecideOnCycle(board, body, foodCell, growing)
+                           : DecideGreedy(board, body, foodCell, growing);
+    if (next < 0) return false;
+
+    dx = next % cols - SnakeBody::X(body.Head());
+    dy = next / cols - SnakeBody::Y(body.Head());
+    return true;
+}
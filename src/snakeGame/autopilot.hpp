@@ -0,0 +1,60 @@
+#pragma once
+#include "occupancy.hpp"
+#include "snakebody.hpp"
+#include <vector>
+#include <cstdint>
+
+// Self-playing Snake. Plans a BFS path to the food and replays it on later
+// ticks without searching again while it stays valid. Whether a step is safe,
+// i.e. keeps a free path to the snake's own tail, is decided one of two ways:
+//  - on boards with an even side there is a Hamiltonian cycle; the snake
+//    keeps its body in cycle order, so the cycle from head to tail is always
+//    free, and only takes BFS shortcuts that do not overtake the tail. This
+//    is what lets it fill the whole board.
+//  - otherwise it replays the plan on a virtual body and checks the tail is
+//    still reachable after eating, chasing its tail when it is not.
+// All search buffers are sized once and reset by bumping a stamp.
+class SnakeAutopilot {
+    private:
+        int cols;
+        int rows;
+        uint32_t stamp;
+        std::vector<uint32_t> seen;     // BFS visit stamp per cell
+        std::vector<uint32_t> blocked;  // virtual-body stamp per cell
+        std::vector<int> parent;
+        std::vector<int> dist;
+        std::vector<int> queue;
+        std::vector<int> plan;          // cells after the head, ending at the food
+        std::vector<int> cycleIdx;      // position of each cell on the cycle
+        std::vector<int> cycleNext;     // cell after this one on the cycle
+        bool hasCycle;
+        bool orderChecked;              // body order tested since Reset()
+        bool bodyOnCycle;               // body lies in cycle order, tail to head
+        int planPos;
+        int planFood;
+        long long plansMade;
+        long long planCells;
+
+        template <typename Passable>
+        bool Bfs(int from, int goal, int minGoalDist, Passable&& passable);
+        bool PlanToFood(const OccupancyGrid& board, const SnakeBody& body, int foodCell, bool growing);
+        bool PlanIsSafe(const OccupancyGrid& board, const SnakeBody& body, bool growing);
+        int ChaseTail(const OccupancyGrid& board, const SnakeBody& body, bool growing);
+        void BuildCycle();
+        int CycleDist(int from, int to) const;
+        bool BodyFollowsCycle(const OccupancyGrid& board, const SnakeBody& body) const;
+        int NextPlanStep(const OccupancyGrid& board, int head, int tail, int foodCell, bool growing);
+        int DecideOnCycle(const OccupancyGrid& board, const SnakeBody& body, int foodCell, bool growing);
+        int DecideGreedy(const OccupancyGrid& board, const SnakeBody& body, int foodCell, bool growing);
+
+    public:
+        SnakeAutopilot()
+        : cols(0), rows(0), stamp(0), hasCycle(false), orderChecked(false), bodyOnCycle(false), planPos(0), planFood(-1), plansMade(0), planCells(0) {};
+        void Reserve(int width, int height);
+        void Reset();
+        // Picks the next move; false when every neighbour is blocked.
+        // foodCell is -1 when there is no food on the board.
+        bool Decide(const OccupancyGrid& board, const SnakeBody& body, int foodCell, bool growing, int& dx, int& dy);
+        long long PlansMade() const {return plansMade;}
+        double AveragePlanLength() const {return plansMade ? (double)planCells / plansMade : 0.0;}
+};
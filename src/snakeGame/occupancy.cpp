@@ -0,0 +1,41 @@
+#include "occupancy.hpp"
+
+void OccupancyGrid::Resize(int width, int height) {
+    cols = width;
+    rows = height;
+    chunkCols = (cols + CHUNK - 1) >> CHUNK_SHIFT;
+    Clear();
+}
+
+void OccupancyGrid::Clear() {
+    int n = cols * rows;
+    bits.assign((n + 63) / 64, 0);
+    chunkCount.assign(chunkCols * ((rows + CHUNK - 1) >> CHUNK_SHIFT), 0);
+    freeCells.resize(n);
+    freeSlot.resize(n);
+    for (int i = 0; i < n; i++) {
+        freeCells[i] = i;
+        freeSlot[i] = i;
+    }
+}
+
+void OccupancyGrid::Occupy(int cell) {
+    if (IsOccupied(cell)) return;
+    bits[cell >> 6] |= uint64_t(1) << (cell & 63);
+    // swap the last free cell into this one's slot
+    int slot = freeSlot[cell];
+    int last = freeCells.back();
+    freeCells[slot] = last;
+    freeSlot[last] = slot;
+    freeCells.pop_back();
+    freeSlot[cell] = -1;
+    chunkCount[ChunkOfCell(cell)]++;
+}
+
+void OccupancyGrid::Release(int cell) {
+    if (!IsOccupied(cell)) return;
+    bits[cell >> 6] &= ~(uint64_t(1) << (cell & 63));
+    freeSlot[cell] = (int)freeCells.size();
+    freeCells.push_back(cell);
+    chunkCount[ChunkOfCell(cell)]--;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+// Which board cells the snake covers. A bitmap answers "is this cell taken"
+// in O(1), and a dense list of free cells (with each cell's position in that
+// list) supports O(1) occupy/release and uniform sampling of a free cell.
+// Per-chunk counts let renderers skip empty CHUNK x CHUNK blocks.
+class OccupancyGrid {
+    public:
+        static const int CHUNK_SHIFT = 4;
+        static const int CHUNK = 1 << CHUNK_SHIFT;
+
+    private:
+        int cols;
+        int rows;
+        int chunkCols;
+        std::vector<uint64_t> bits;
+        std::vector<int> freeCells;
+        std::vector<int> freeSlot;   // index into freeCells, -1 when occupied
+        std::vector<uint16_t> chunkCount;
+
+        int ChunkOfCell(int cell) const {return ((cell / cols) >> CHUNK_SHIFT) * chunkCols + ((cell % cols) >> CHUNK_SHIFT);}
+
+    public:
+        OccupancyGrid() : cols(0), rows(0), chunkCols(0) {};
+        void Resize(int width, int height);
+        void Clear();
+        int Cell(int x, int y) const {return y * cols + x;}
+        bool InBounds(int x, int y) const {return x >= 0 && x < cols && y >= 0 && y < rows;}
+        bool IsOccupied(int cell) const {return (bits[cell >> 6] >> (cell & 63)) & 1;}
+        void Occupy(int cell);
+        void Release(int cell);
+        int FreeCount() const {return (int)freeCells.size();}
+        int FreeCellAt(int i) const {return freeCells[i];}
+        int GetCols() const {return cols;}
+        int GetRows() const {return rows;}
+        // Occupied cells in the chunk at chunk coordinates (cx, cy).
+        int ChunkCount(int cx, int cy) const {return chunkCount[cy * chunkCols + cx];}
+};
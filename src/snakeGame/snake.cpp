@@ -1,79 +1,207 @@
 #include "snake.hpp"
-#include <raymath.h>
+#include "occupancy.hpp"
+#include "snakebody.hpp"
+#include "autopilot.hpp"
+#include "turnqueue.hpp"
+#include "arena.hpp"
+#include "../common/bench.hpp"
+#include "../common/assetpack.hpp"
+#include "../common/session.hpp"
 #include <fstream>
 #include <string>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <algorithm>
+#include <cmath>
 using namespace std;
 
 // Colors and layout
 static const Color SNAKE_GREEN = {120,230,92,255};
 static const Color FOREST_GREEN = {30,102,12,255};
 static const int CELL_SIZE = 20;
-static const int CELL_COUNT_W = 48;
-static const int CELL_COUNT_H = 32;
+static const int VIEW_COLS = 48;   // cells visible at once; the board may be larger
+static const int VIEW_ROWS = 32;
+static const int VIEW_W = VIEW_COLS * CELL_SIZE;
+static const int VIEW_H = VIEW_ROWS * CELL_SIZE;
 static const int OFFSET_X = 75;
 static const int OFFSET_Y = 75;
+// Board size limits; the start body sits at (14..16, 15)
+static const int BOARD_MIN_W = 20;
+static const int BOARD_MIN_H = 16;
+static const int BOARD_MAX = 2048;
+static const int BOARD_PRESETS[][2] = {{48, 32}, {256, 160}, {1024, 640}, {2048, 2048}};
+// Arena: same footprint as the normal board, at a quarter of the cell size
+static const int ARENA_CELL = 5;
+static const int ARENA_W = VIEW_W / ARENA_CELL;
+static const int ARENA_H = VIEW_H / ARENA_CELL;
+static const int ARENA_MAX_LEN = 64;
+static const int ARENA_MIN_SNAKES = 16;
+static const int ARENA_MAX_SNAKES = 1024;
 
 // Timing and game state
 enum class SState { Start, Countdown, Playing, GameOver };
 static SState state;
 static double lastUpdateTime;
 static double countdownStart;
+static double suspendedAt = -1; // while the window is in the background
 static int score;
 static int highScore;
+static int savedHighScore; // what highscore.txt holds
 
 // Audio
 static Sound eatSound;
 static Sound collSound;
 
 // Snake and food data
-static deque<Vector2> body;
-static Vector2 direction;
+static SnakeBody body;        // packed cells, tail to head
+static int dirX, dirY;
 static bool addSegment;
 static Texture2D foodTex;
-static Vector2 foodPos;
+static int foodX, foodY;      // -1 when the board is full
+static OccupancyGrid board;   // cells under the snake, kept in step with body
+static int boardW = VIEW_COLS;
+static int boardH = VIEW_ROWS;
+static int boardPreset = 0;
+static RenderTexture2D segSprite; // one rounded segment, drawn once
+static SnakeAutopilot autopilot;
+static bool autopilotSized = false; // search buffers are big on large boards
+static bool autoplay = false;
+
+// Input: turns wait here for the movement tick that applies them
+static TurnQueue turns;
+static double lastLatencyMs;  // key press to the move that used it
+static double avgLatencyMs;   // smoothed over recent turns
+
+// Arena mode: many AI snakes, decided in parallel
+static SnakeArena arena;
+static bool arenaMode = false;
+static int arenaSnakes = 64;
+static double arenaStepMs;    // smoothed cost of one arena tick
 
 // Helpers
-static bool ElemInDeque(const Vector2& v, const deque<Vector2>& dq) {
-    for (auto &e : dq) if (Vector2Equals(e, v)) return true;
-    return false;
+static void EnsureAutopilot() {
+    if (autopilotSized) return;
+    autopilot.Reserve(boardW, boardH);
+    autopilotSized = true;
+}
+static void ResizeBoard() {
+    board.Resize(boardW, boardH);
+    body.Reserve(boardW * boardH);
+    autopilotSized = false;
+    if (autoplay) EnsureAutopilot();
 }
-static Vector2 RandCell() {
-    return { (float)GetRandomValue(0, CELL_COUNT_W-1), (float)GetRandomValue(0, CELL_COUNT_H-1) };
+static int CellOf(uint32_t p) {
+    return board.Cell(SnakeBody::X(p), SnakeBody::Y(p));
+}
+static void ResetBody() {
+    body.Clear();
+    board.Clear();
+    for (int x = 14; x <= 16; x++) {
+        body.PushHead(SnakeBody::Pack(x, 15));
+        board.Occupy(board.Cell(x, 15));
+    }
+    dirX = 1; dirY = 0;
+    addSegment = false;
+    turns.Clear();
+    autopilot.Reset();
 }
+// uniform over free cells, so constant time however long the snake is
 static void PlaceFood() {
-    Vector2 p = RandCell();
-    while (ElemInDeque(p, body)) p = RandCell();
-    foodPos = p;
+    if (board.FreeCount() == 0) { foodX = foodY = -1; return; }
+    int cell = board.FreeCellAt(Session().Random(0, board.FreeCount()-1));
+    foodX = cell % boardW;
+    foodY = cell / boardW;
 }
 static bool Interval(double interval) {
-    double t = GetTime();
+    double t = Session().Time();
     if (t - lastUpdateTime >= interval) { lastUpdateTime = t; return true; }
     return false;
 }
+static void QueueTurnKeys() {
+    double t = Session().Time();
+    if (Session().KeyPressed(KEY_UP)) turns.Push(0, -1, t, dirX, dirY);
+    if (Session().KeyPressed(KEY_DOWN)) turns.Push(0, 1, t, dirX, dirY);
+    if (Session().KeyPressed(KEY_LEFT)) turns.Push(-1, 0, t, dirX, dirY);
+    if (Session().KeyPressed(KEY_RIGHT)) turns.Push(1, 0, t, dirX, dirY);
+}
+// Applies the oldest queued turn, if any, and records how long it waited.
+static void ApplyQueuedTurn() {
+    TurnQueue::Turn turn;
+    if (!turns.Pop(turn)) return;
+    dirX = turn.dx; dirY = turn.dy;
+    lastLatencyMs = (Session().Time() - turn.pressedAt) * 1000.0;
+    avgLatencyMs = avgLatencyMs > 0 ? avgLatencyMs * 0.9 + lastLatencyMs * 0.1 : lastLatencyMs;
+}
+// One movement tick. Sound and scoring are left to the caller so the
+// headless runner can share it.
+enum class StepResult { Moved, Ate, Crashed };
+static StepResult StepSnake() {
+    int hx = SnakeBody::X(body.Head()) + dirX;
+    int hy = SnakeBody::Y(body.Head()) + dirY;
+    // the tail moves out first, so following it is allowed
+    if (!addSegment) { board.Release(CellOf(body.Tail())); body.PopTail(); }
+    else addSegment = false;
+    // Edge collision
+    if (!board.InBounds(hx, hy)) return StepResult::Crashed;
+    // Self collision
+    int cell = board.Cell(hx, hy);
+    if (board.IsOccupied(cell)) return StepResult::Crashed;
+    body.PushHead(SnakeBody::Pack(hx, hy));
+    board.Occupy(cell);
+    // Food collision
+    if (hx == foodX && hy == foodY) {
+        addSegment = true; PlaceFood();
+        return StepResult::Ate;
+    }
+    return StepResult::Moved;
+}
+static void SteerAutopilot() {
+    int foodCell = foodX >= 0 ? board.Cell(foodX, foodY) : -1;
+    int dx, dy;
+    if (autopilot.Decide(board, body, foodCell, addSegment, dx, dy)) { dirX = dx; dirY = dy; }
+}
+static void StartArena() {
+    arena.Init(ARENA_W, ARENA_H, arenaSnakes, ARENA_MAX_LEN, Jobs().Size(), (uint64_t)Session().Random(1, 1 << 30));
+    arenaStepMs = 0;
+}
+static void StepArena() {
+    auto t0 = chrono::steady_clock::now();
+    arena.Step(Jobs());
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    arenaStepMs = arenaStepMs > 0 ? arenaStepMs * 0.9 + ms * 0.1 : ms;
+}
 static void LoadHighScore() {
     ifstream f("src/snakeGame/highscore.txt"); if (f >> highScore) {};
+    savedHighScore = highScore;
 }
+// Only a new record is written, so an ordinary game over opens no file
 static void SaveHighScore() {
+    if (highScore == savedHighScore) return;
     ofstream f("src/snakeGame/highscore.txt"); if (f.is_open()) f << highScore;
+    savedHighScore = highScore;
 }
 
 bool InitSnake() {
     InitAudioDevice();
-    eatSound = LoadSound("data/snake/SE/eat.mp3");
-    collSound = LoadSound("data/snake/SE/coll.mp3");
+    eatSound = Assets().LoadSound("data/snake/SE/eat.mp3");
+    collSound = Assets().LoadSound("data/snake/SE/coll.mp3");
     LoadHighScore(); score = 0;
 
     // Initialize snake
-    body = {{16,15},{15,15},{14,15}};
-    direction = {1,0};
-    addSegment = false;
-    lastUpdateTime = GetTime();
+    ResizeBoard();
+    ResetBody();
+    lastUpdateTime = Session().Time();
+
+    // Load food, baked at cell size by the packer (see assets.cfg)
+    foodTex = Assets().LoadTexture("data/snake/Graphics/food.png", CELL_SIZE, CELL_SIZE);
 
-    // Load food
-    Image img = LoadImage("data/snake/Graphics/food.png");
-    ImageResize(&img, CELL_SIZE, CELL_SIZE);
-    foodTex = LoadTextureFromImage(img);
-    UnloadImage(img);
+    // Segment sprite, so drawing the body is one batch of textured quads
+    segSprite = LoadRenderTexture(CELL_SIZE, CELL_SIZE);
+    BeginTextureMode(segSprite);
+    ClearBackground(BLANK);
+    DrawRectangleRounded({0, 0, (float)CELL_SIZE, (float)CELL_SIZE}, 0.7f, 8, FOREST_GREEN);
+    EndTextureMode();
     PlaceFood();
 
     state = SState::Start;
@@ -83,86 +211,299 @@ bool InitSnake() {
 
 void UpdateSnake() {
     // Global back to menu
-    if (IsKeyPressed(KEY_BACKSPACE) && state != SState::Start) {
+    if (Session().KeyPressed(KEY_BACKSPACE) && state != SState::Start) {
         state = SState::Start; score = 0; PlaceFood(); return;
     }
     // Input
-    if (state == SState::Playing) {
-        if (IsKeyPressed(KEY_UP) && direction.y != 1) direction = {0,-1};
-        if (IsKeyPressed(KEY_DOWN) && direction.y != -1) direction = {0,1};
-        if (IsKeyPressed(KEY_LEFT) && direction.x != 1) direction = {-1,0};
-        if (IsKeyPressed(KEY_RIGHT)&& direction.x != -1) direction = {1,0};
-    }
+    if (state == SState::Playing && !autoplay) QueueTurnKeys();
     switch (state) {
         case SState::Start:
-            if (IsKeyPressed(KEY_ENTER)) { state = SState::Countdown; countdownStart = GetTime(); }
+            if (Session().KeyPressed(KEY_A)) { autoplay = !autoplay; if (autoplay) EnsureAutopilot(); autopilot.Reset(); }
+            if (Session().KeyPressed(KEY_B)) {
+                boardPreset = (boardPreset + 1) % (int)(sizeof(BOARD_PRESETS) / sizeof(BOARD_PRESETS[0]));
+                SetSnakeBoardSize(BOARD_PRESETS[boardPreset][0], BOARD_PRESETS[boardPreset][1]);
+                ResizeBoard(); ResetBody(); PlaceFood();
+            }
+            if (Session().KeyPressed(KEY_M)) arenaMode = !arenaMode;
+            if (arenaMode && Session().KeyPressed(KEY_UP)) arenaSnakes = min(arenaSnakes * 2, ARENA_MAX_SNAKES);
+            if (arenaMode && Session().KeyPressed(KEY_DOWN)) arenaSnakes = max(arenaSnakes / 2, ARENA_MIN_SNAKES);
+            if (Session().KeyPressed(KEY_ENTER)) {
+                if (arenaMode) { StartArena(); state = SState::Playing; lastUpdateTime = Session().Time(); }
+                else { state = SState::Countdown; countdownStart = Session().Time(); }
+            }
             break;
         case SState::Countdown:
-            if (GetTime() - countdownStart >= 3.0) { state = SState::Playing; lastUpdateTime = GetTime(); }
+            if (Session().Time() - countdownStart >= 3.0) { state = SState::Playing; lastUpdateTime = Session().Time(); turns.Clear(); }
             break;
         case SState::Playing:
+            if (arenaMode) {
+                if (Interval(0.05)) StepArena();
+                break;
+            }
             if (Interval(0.1)) {
-                Vector2 head = body.front();
-                body.push_front(Vector2Add(head, direction));
-                if (!addSegment) body.pop_back(); else addSegment = false;
-                // Food collision
-                if (Vector2Equals(body.front(), foodPos)) {
-                    addSegment = true; score++; if (score > highScore) highScore = score;
-                    PlaySound(eatSound); PlaceFood();
-                }
-                // Edge collision
-                auto &h = body.front();
-                if (h.x < 0 || h.x >= CELL_COUNT_W || h.y < 0 || h.y >= CELL_COUNT_H) {
-                    state = SState::GameOver; PlaySound(collSound); SaveHighScore();
-                }
-                // Self collision
-                deque<Vector2> tmp = body; tmp.pop_front();
-                if (ElemInDeque(body.front(), tmp)) {
-                    state = SState::GameOver; PlaySound(collSound); SaveHighScore();
+                if (autoplay) SteerAutopilot();
+                else ApplyQueuedTurn();
+                switch (StepSnake()) {
+                    case StepResult::Crashed:
+                        state = SState::GameOver; PlaySound(collSound); SaveHighScore();
+                        break;
+                    case StepResult::Ate:
+                        score++; if (score > highScore) highScore = score;
+                        PlaySound(eatSound);
+                        break;
+                    case StepResult::Moved:
+                        break;
                 }
             }
             break;
         case SState::GameOver:
-            if (IsKeyPressed(KEY_R)) {
-                body = {{16,15},{15,15},{14,15}}; direction = {1,0}; score = 0; PlaceFood(); state = SState::Start;
+            if (Session().KeyPressed(KEY_R)) {
+                ResetBody(); score = 0; PlaceFood(); state = SState::Start;
             }
             break;
     }
 }
 
+// Top-left board pixel in view: centred on the head, clamped to the board.
+static Vector2 ViewOrigin() {
+    float px = (SnakeBody::X(body.Head()) + 0.5f) * CELL_SIZE - VIEW_W / 2.0f;
+    float py = (SnakeBody::Y(body.Head()) + 0.5f) * CELL_SIZE - VIEW_H / 2.0f;
+    float maxX = (float)(boardW * CELL_SIZE - VIEW_W), maxY = (float)(boardH * CELL_SIZE - VIEW_H);
+    px = maxX > 0 ? clamp(px, 0.0f, maxX) : maxX / 2;
+    py = maxY > 0 ? clamp(py, 0.0f, maxY) : maxY / 2;
+    return {floorf(px), floorf(py)};
+}
+// Draws only the chunks under the viewport, testing occupancy bits instead
+// of walking the body, so the cost follows the view rather than the length.
+static void DrawBoardView() {
+    Vector2 origin = ViewOrigin();
+    Camera2D cam = {{(float)OFFSET_X, (float)OFFSET_Y}, origin, 0.0f, 1.0f};
+    int x0 = max(0, (int)origin.x / CELL_SIZE), y0 = max(0, (int)origin.y / CELL_SIZE);
+    int x1 = min(boardW, x0 + VIEW_COLS + 1), y1 = min(boardH, y0 + VIEW_ROWS + 1);
+    // render textures are stored upside down
+    Rectangle src = {0, 0, (float)CELL_SIZE, -(float)CELL_SIZE};
+
+    BeginScissorMode(OFFSET_X, OFFSET_Y, VIEW_W, VIEW_H);
+    BeginMode2D(cam);
+    if (foodX >= 0) DrawTexture(foodTex, foodX*CELL_SIZE, foodY*CELL_SIZE, WHITE);
+    const int C = OccupancyGrid::CHUNK_SHIFT;
+    for (int cy = y0 >> C; cy <= (y1 - 1) >> C; cy++) {
+        for (int cx = x0 >> C; cx <= (x1 - 1) >> C; cx++) {
+            if (board.ChunkCount(cx, cy) == 0) continue;
+            int yEnd = min(y1, (cy + 1) << C), xEnd = min(x1, (cx + 1) << C);
+            for (int y = max(y0, cy << C); y < yEnd; y++) {
+                for (int x = max(x0, cx << C); x < xEnd; x++) {
+                    if (board.IsOccupied(board.Cell(x, y)))
+                        DrawTextureRec(segSprite.texture, src, {(float)(x*CELL_SIZE), (float)(y*CELL_SIZE)}, WHITE);
+                }
+            }
+        }
+    }
+    EndMode2D();
+    EndScissorMode();
+}
+
 void DrawSnake() {
     ClearBackground(SNAKE_GREEN);
     // Inner box
     DrawRectangleLinesEx({(float)OFFSET_X+40,(float)OFFSET_Y-5,
-        (float)(CELL_COUNT_W*CELL_SIZE+10),(float)(CELL_COUNT_H*CELL_SIZE+10)},
+        (float)(VIEW_COLS*CELL_SIZE+10),(float)(VIEW_ROWS*CELL_SIZE+10)},
         5, FOREST_GREEN);
     // Title
     DrawText("Snakey Snake", OFFSET_X+40, OFFSET_Y - 50, 40, FOREST_GREEN);
     switch (state) {
         case SState::Start:
-            DrawText("Press ENTER to start", OFFSET_X+60, OFFSET_Y + CELL_COUNT_H*CELL_SIZE/2 - 40, 30, FOREST_GREEN);
+            DrawText("Press ENTER to start", OFFSET_X+60, OFFSET_Y + VIEW_ROWS*CELL_SIZE/2 - 40, 30, FOREST_GREEN);
+            DrawText(TextFormat("A: autopilot [%s]", autoplay ? "ON" : "OFF"), OFFSET_X+60, OFFSET_Y + VIEW_ROWS*CELL_SIZE/2, 20, FOREST_GREEN);
+            DrawText(TextFormat("M: arena [%s]", arenaMode ? "ON" : "OFF"), OFFSET_X+60, OFFSET_Y + VIEW_ROWS*CELL_SIZE/2 + 30, 20, FOREST_GREEN);
+            if (arenaMode) DrawText(TextFormat("UP/DOWN: %i snakes", arenaSnakes), OFFSET_X+60, OFFSET_Y + VIEW_ROWS*CELL_SIZE/2 + 60, 20, FOREST_GREEN);
+            else DrawText(TextFormat("B: board %ix%i", boardW, boardH), OFFSET_X+60, OFFSET_Y + VIEW_ROWS*CELL_SIZE/2 + 60, 20, FOREST_GREEN);
             break;
         case SState::Countdown: {
-            int cnt = 3 - (int)(GetTime() - countdownStart);
-            DrawText(TextFormat("%i", cnt), GetScreenWidth()/2 - 10, OFFSET_Y + CELL_COUNT_H*CELL_SIZE/2 - 20, 60, FOREST_GREEN);
+            int cnt = 3 - (int)(Session().Time() - countdownStart);
+            DrawText(TextFormat("%i", cnt), GetScreenWidth()/2 - 10, OFFSET_Y + VIEW_ROWS*CELL_SIZE/2 - 20, 60, FOREST_GREEN);
             break;
         }
         case SState::Playing:
-            DrawTexture(foodTex, OFFSET_X + foodPos.x*CELL_SIZE, OFFSET_Y + foodPos.y*CELL_SIZE, WHITE);
-            for (auto &seg : body) DrawRectangleRounded({OFFSET_X + seg.x*CELL_SIZE, OFFSET_Y + seg.y*CELL_SIZE, (float)CELL_SIZE, (float)CELL_SIZE}, 0.7f, 8, FOREST_GREEN);
+            if (arenaMode) {
+                arena.Draw(OFFSET_X+45, OFFSET_Y, ARENA_CELL);
+                const char* stats = TextFormat("Alive %i/%i  Longest %i  Tick %.2f ms  Threads %i",
+                    arena.Alive(), arena.Count(), arena.Longest(), arenaStepMs, Jobs().Size());
+                DrawText(stats, GetScreenWidth()/2 - MeasureText(stats, 20)/2, OFFSET_Y + VIEW_ROWS*CELL_SIZE + 10, 20, FOREST_GREEN);
+                break;
+            }
+            DrawBoardView();
+            if (!autoplay) {
+                const char* lat = TextFormat("Input lag: %.0f ms (avg %.0f)", lastLatencyMs, avgLatencyMs);
+                DrawText(lat, GetScreenWidth()/2 - MeasureText(lat, 20)/2, OFFSET_Y + VIEW_ROWS*CELL_SIZE + 10, 20, FOREST_GREEN);
+            }
             break;
         case SState::GameOver:
-            DrawText("Game Over! Press R to restart", OFFSET_X+60, OFFSET_Y + CELL_COUNT_H*CELL_SIZE/2 -20, 30, FOREST_GREEN);
+            DrawText("Game Over! Press R to restart", OFFSET_X+60, OFFSET_Y + VIEW_ROWS*CELL_SIZE/2 -20, 30, FOREST_GREEN);
             break;
     }
     // Footer: scores
-    DrawText(TextFormat("Score: %i", score), OFFSET_X+40, OFFSET_Y + CELL_COUNT_H*CELL_SIZE + 10, 20, FOREST_GREEN);
-    DrawText(TextFormat("High: %i", highScore), GetScreenWidth() - OFFSET_X - MeasureText("High: 0000", 20)-20, OFFSET_Y + CELL_COUNT_H*CELL_SIZE + 10, 20, FOREST_GREEN);
+    DrawText(TextFormat("Score: %i", score), OFFSET_X+40, OFFSET_Y + VIEW_ROWS*CELL_SIZE + 10, 20, FOREST_GREEN);
+    DrawText(TextFormat("High: %i", highScore), GetScreenWidth() - OFFSET_X - MeasureText("High: 0000", 20)-20, OFFSET_Y + VIEW_ROWS*CELL_SIZE + 10, 20, FOREST_GREEN);
 }
 
 void UnloadSnake() {
     UnloadTexture(foodTex);
+    UnloadRenderTexture(segSprite);
     UnloadSound(eatSound);
     UnloadSound(collSound);
     CloseAudioDevice();
 }
+
+// Autopilot soak test without a window: plays each game until the board is
+// full, the snake crashes or it stops making progress, then prints rates.
+int RunSnakeHeadless(int games) {
+    const int cells = boardW * boardH;
+    const long long tickLimit = (long long)cells * cells; // stalled well before this
+    autoplay = true;
+    ResizeBoard();
+    Session().SeedRandom(1);
+
+    long long totalTicks = 0, totalPlans = 0;
+    double totalPlanCells = 0, worstTickMs = 0;
+    int filled = 0, crashed = 0, stalled = 0;
+    auto start = chrono::steady_clock::now();
+    for (int g = 0; g < games; g++) {
+        ResetBody();
+        PlaceFood();
+        long long ticks = 0;
+        bool over = false;
+        while (!over) {
+            auto t0 = chrono::steady_clock::now();
+            SteerAutopilot();
+            StepResult r = StepSnake();
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+            if (ms > worstTickMs) worstTickMs = ms;
+            ticks++;
+            if (r == StepResult::Crashed) { crashed++; over = true; }
+            else if (board.FreeCount() == 0) { filled++; over = true; }
+            else if (ticks >= tickLimit) { stalled++; over = true; }
+        }
+        totalTicks += ticks;
+        totalPlans += autopilot.PlansMade();
+        totalPlanCells += autopilot.AveragePlanLength() * autopilot.PlansMade();
+        printf("game %d: length %d/%d after %lld ticks\n", g + 1, body.Length(), cells, ticks);
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    printf("games: %d  filled: %d  crashed: %d  stalled: %d\n", games, filled, crashed, stalled);
+    printf("ticks: %lld  ticks/s: %.0f  worst tick: %.3f ms\n", totalTicks, totalTicks / secs, worstTickMs);
+    printf("paths: %lld  average path length: %.2f\n", totalPlans, totalPlans ? totalPlanCells / totalPlans : 0.0);
+    return crashed == 0 ? 0 : 1;
+}
+
+// Arena scaling run without a window: doubles the snake count up to
+// maxSnakes and prints ticks/s for each, single-threaded and on the shared
+// job system, with how busy its workers were. The checksums must match,
+// since resolution does not depend on threads.
+int RunSnakeArenaBench(int maxSnakes) {
+    const int ticks = 1000;
+    JobSystem single;   // never started, so it runs everything inline
+    JobSystem& shared = Jobs();
+    int mismatches = 0;
+    printf("arena %dx%d, %d ticks, %d threads\n", ARENA_W, ARENA_H, ticks, shared.Size());
+    printf("%8s %12s %12s %8s %8s %8s\n", "snakes", "ticks/s x1", "ticks/s xN", "busy %", "alive", "deaths");
+    for (int snakes = ARENA_MIN_SNAKES; snakes <= maxSnakes; snakes *= 2) {
+        double rate[2];
+        uint64_t sums[2];
+        float busy = 0;
+        for (int run = 0; run < 2; run++) {
+            JobSystem& jobs = run == 0 ? single : shared;
+            arena.Init(ARENA_W, ARENA_H, snakes, ARENA_MAX_LEN, jobs.Size(), 12345);
+            jobs.Sample();
+            auto start = chrono::steady_clock::now();
+            for (int t = 0; t < ticks; t++) arena.Step(jobs);
+            double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            JobStats stats = jobs.Sample();
+            // each run starts over, so the row shows the shared system's
+            // workers only; the inline run would read as 100% on its own
+            busy = 0;
+            for (int w = 0; w < stats.workers; w++) busy += stats.busy[w] / stats.workers;
+            rate[run] = ticks / secs;
+            sums[run] = arena.Checksum();
+        }
+        if (sums[0] != sums[1]) mismatches++;
+        printf("%8d %12.0f %12.0f %8.0f %8d %8d%s\n", snakes, rate[0], rate[1], busy * 100.0f, arena.Alive(), arena.Deaths(),
+            sums[0] != sums[1] ? "  CHECKSUM MISMATCH" : "");
+    }
+    return mismatches == 0 ? 0 : 1;
+}
+
+bool SuspendSnake(bool suspended) {
+    if (suspended) {
+        suspendedAt = Session().Time();
+    } else if (suspendedAt >= 0) {
+        double away = Session().Time() - suspendedAt;
+        countdownStart += away;
+        lastUpdateTime += away;
+        turns.Clear();
+        suspendedAt = -1;
+    }
+    return true;
+}
+
+void SetSnakeBoardSize(int width, int height) {
+    boardW = clamp(width, BOARD_MIN_W, BOARD_MAX);
+    boardH = clamp(height, BOARD_MIN_H, BOARD_MAX);
+}
+
+// --- Benchmarks ---
+// The snake follows a Hamiltonian cycle over the board (right and left along
+// the rows, back up column 0), so it can be stepped forever without eating
+// or crashing. Needs an even number of rows.
+static void SteerAlongCycle() {
+    int x = SnakeBody::X(body.Head()), y = SnakeBody::Y(body.Head());
+    dirX = dirY = 0;
+    if (x == 0) { if (y > 0) dirY = -1; else dirX = 1; }
+    else if (y % 2 == 0) { if (x < boardW - 1) dirX = 1; else dirY = 1; }
+    else if (x > 1 || y == boardH - 1) dirX = -1;
+    else dirY = 1;
+}
+// size x size board with the snake over half of it and no food
+static int savedBoardW, savedBoardH;
+static void SetupBenchBoard(int size, uint64_t seed) {
+    savedBoardW = boardW;
+    savedBoardH = boardH;
+    SetSnakeBoardSize(size, size);
+    ResizeBoard();
+    body.Clear();
+    board.Clear();
+    body.PushHead(SnakeBody::Pack(0, 0));
+    board.Occupy(board.Cell(0, 0));
+    foodX = foodY = -1;
+    for (int i = 1; i < size * size / 2; i++) {
+        addSegment = true;
+        SteerAlongCycle();
+        StepSnake();
+    }
+    Session().SeedRandom(seed);
+}
+static void TeardownBenchBoard() {
+    SetSnakeBoardSize(savedBoardW, savedBoardH);
+    ResizeBoard();
+    ResetBody();
+    PlaceFood();
+}
+
+void AddSnakeBenchmarks(BenchSuite& suite) {
+    // one movement tick: tail out, edge and self collision, head in
+    suite.Add({"snake/step", "cells per side", {32, 256, 2048},
+        SetupBenchBoard,
+        [] {
+            SteerAlongCycle();
+            BenchSink((uint64_t)StepSnake());
+        },
+        TeardownBenchBoard});
+    // a new food cell, drawn from the free list with the board half full
+    suite.Add({"snake/place-food", "cells per side", {32, 256, 2048},
+        SetupBenchBoard,
+        [] {
+            PlaceFood();
+            BenchSink(foodY * boardW + foodX);
+        },
+        TeardownBenchBoard});
+}
@@ -1,8 +1,20 @@
 #pragma once
 #include "raylib.h"
-#include <deque>
+
+class BenchSuite;
 
 bool InitSnake();
 void UpdateSnake();
 void DrawSnake();
-void UnloadSnake();
\ No newline at end of file
+void UnloadSnake();
+// Pauses the game clock while the window is in the background.
+bool SuspendSnake(bool suspended);
+// Board size in cells, clamped to 20x16..2048x2048; the view scrolls to
+// follow the head when the board is larger than the window.
+void SetSnakeBoardSize(int width, int height);
+// Plays `games` autopilot games without a window and prints throughput.
+int RunSnakeHeadless(int games);
+// Runs the AI arena at growing snake counts and prints ticks per second.
+int RunSnakeArenaBench(int maxSnakes);
+// Adds the movement tick and food placement on growing boards to ArcadeBench.
+void AddSnakeBenchmarks(BenchSuite& suite);
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include "snakebody.hpp"
+
+void SnakeBody::Reserve(int cells) {
+    ring.assign(cells, 0);
+    Clear();
+}
+
+void SnakeBody::PushHead(uint32_t p) {
+    int slot = start + length;
+    if (slot >= (int)ring.size()) slot -= (int)ring.size();
+    ring[slot] = p;
+    length++;
+}
+
+void SnakeBody::PopTail() {
+    start++;
+    if (start == (int)ring.size()) start = 0;
+    length--;
+}
+
+uint32_t SnakeBody::Head() const {
+    int slot = start + length - 1;
+    if (slot >= (int)ring.size()) slot -= (int)ring.size();
+    return ring[slot];
+}
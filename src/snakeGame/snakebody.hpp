@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+// Snake segments in a fixed ring buffer of packed cell coordinates, sized to
+// the board so it never reallocates. Moving is one head write plus one tail
+// advance; the segments are at most two contiguous runs of memory.
+class SnakeBody {
+    private:
+        std::vector<uint32_t> ring;
+        int start;    // slot of the tail
+        int length;
+
+    public:
+        static uint32_t Pack(int x, int y) {return (uint32_t)x | ((uint32_t)y << 16);}
+        static int X(uint32_t p) {return (int)(p & 0xFFFF);}
+        static int Y(uint32_t p) {return (int)(p >> 16);}
+
+        SnakeBody() : start(0), length(0) {};
+        void Reserve(int cells);
+        void Clear() {start = 0; length = 0;}
+        void PushHead(uint32_t p);
+        void PopTail();
+        uint32_t Head() const;
+        uint32_t Tail() const {return ring[start];}
+        int Length() const {return length;}
+        int Capacity() const {return (int)ring.size();}
+
+        // Calls fn(packed) from tail to head, walking the two runs in order.
+        template <typename F>
+        void ForEach(F&& fn) const {
+            int cap = (int)ring.size();
+            int firstEnd = start + length < cap ? start + length : cap;
+            for (int i = start; i < firstEnd; i++) fn(ring[i]);
+            for (int i = 0; i < start + length - cap; i++) fn(ring[i]);
+        }
+};
@@ -0,0 +1,22 @@
+#include "snake.hpp"
+#include "../gamemodule.hpp"
+#include <cstring>
+#include <cstdio>
+
+static int SnakeCommand(int argc, char** argv, int* i) {
+    const char* arg = argv[*i];
+    if (strcmp(arg, "--snake-board") == 0 && *i + 1 < argc) {
+        int w = 0, h = 0;
+        if (sscanf(argv[++*i], "%dx%d", &w, &h) == 2) SetSnakeBoardSize(w, h);
+    } else if (strcmp(arg, "--snake-headless") == 0) {
+        return RunSnakeHeadless(OptionalCount(argc, argv, i, 1));
+    } else if (strcmp(arg, "--snake-arena") == 0) {
+        return RunSnakeArenaBench(OptionalCount(argc, argv, i, 512));
+    }
+    return -1;
+}
+
+extern "C" const GameModule* ArcadeGetModule() {
+    static const GameModule module = {"Snake", InitSnake, UpdateSnake, DrawSnake, UnloadSnake, SuspendSnake, SnakeCommand, AddSnakeBenchmarks};
+    return &module;
+}
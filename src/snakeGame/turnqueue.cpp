@@ -0,0 +1,23 @@
+#include "turnqueue.hpp"
+
+bool TurnQueue::Push(int dx, int dy, double pressedAt, int curDx, int curDy) {
+    if (count == CAPACITY) return false;
+    // the direction in effect after every queued turn has been applied
+    if (count > 0) {
+        const Turn& last = turns[(start + count - 1) % CAPACITY];
+        curDx = last.dx; curDy = last.dy;
+    }
+    if (dx == curDx && dy == curDy) return false;
+    if (dx == -curDx && dy == -curDy) return false;
+    turns[(start + count) % CAPACITY] = {dx, dy, pressedAt};
+    count++;
+    return true;
+}
+
+bool TurnQueue::Pop(Turn& out) {
+    if (count == 0) return false;
+    out = turns[start];
+    start = (start + 1) % CAPACITY;
+    count--;
+    return true;
+}
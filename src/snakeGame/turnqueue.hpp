@@ -0,0 +1,26 @@
+#pragma once
+
+// Turns pressed between movement ticks, oldest first. Each press is checked
+// against the direction the snake will have once the turns ahead of it are
+// applied, so quick double turns are kept instead of overwriting or
+// rejecting each other. The bounded look-ahead stops a key burst from
+// steering the snake for many ticks.
+class TurnQueue {
+    public:
+        static const int CAPACITY = 3;
+        struct Turn { int dx; int dy; double pressedAt; };
+
+    private:
+        Turn turns[CAPACITY];
+        int start;
+        int count;
+
+    public:
+        TurnQueue() : start(0), count(0) {};
+        void Clear() {start = 0; count = 0;}
+        // False when the turn is a no-op, a reversal or past the look-ahead.
+        bool Push(int dx, int dy, double pressedAt, int curDx, int curDy);
+        // Oldest turn, at most one per movement tick.
+        bool Pop(Turn& out);
+        int Size() const {return count;}
+};
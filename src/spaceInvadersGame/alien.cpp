@@ -1,24 +1,27 @@
 #include "alien.hpp"
+#include "../common/assetpack.hpp"
+#include <raymath.h>
 
 Texture2D Alien::alienImages[3] = {};
 
 Alien::Alien(int type, Vector2 position) {
     this -> type = type;
     this -> position = position;
+    this -> previousPosition = position;
 
     if (alienImages[type - 1].id == 0) {
         switch(type) {
             case 1:
-                alienImages[0] = LoadTexture("data/spaceInvaders/Graphics/alien_1.png");
+                alienImages[0] = Assets().LoadTexture("data/spaceInvaders/Graphics/alien_1.png");
                 break;
             case 2:
-                alienImages[1] = LoadTexture("data/spaceInvaders/Graphics/alien_2.png");
+                alienImages[1] = Assets().LoadTexture("data/spaceInvaders/Graphics/alien_2.png");
                 break;
             case 3:
-                alienImages[2] = LoadTexture("data/spaceInvaders/Graphics/alien_3.png");
+                alienImages[2] = Assets().LoadTexture("data/spaceInvaders/Graphics/alien_3.png");
                 break;
             default:
-                alienImages[0] = LoadTexture("data/spaceInvaders/Graphics/alien_1.png");
+                alienImages[0] = Assets().LoadTexture("data/spaceInvaders/Graphics/alien_1.png");
                 break;
         }
     }
@@ -26,8 +29,12 @@ Alien::Alien(int type, Vector2 position) {
     
 }
 
-void Alien::Draw() {
-    DrawTextureV(alienImages[type-1], position, WHITE);
+void Alien::Draw(float alpha) {
+    DrawTextureV(alienImages[type-1], Vector2Lerp(previousPosition, position, alpha), WHITE);
+}
+
+void Alien::KeepPosition() {
+    previousPosition = position;
 }
 
 int Alien::GetType() {
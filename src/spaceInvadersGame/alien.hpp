@@ -6,12 +6,14 @@ class Alien {
 
     public:
         Alien(int type, Vector2 position);
-        void Draw();
+        void Draw(float alpha);
+        void KeepPosition();
         void Update(int direction, float speedMul);
         int GetType();
         static void UnloadImages();
         static Texture2D alienImages[3];
         int type;
         Vector2 position;
+        Vector2 previousPosition;   // at the start of the step
         Rectangle getRect();
 };
\ No newline at end of file
@@ -1,10 +1,14 @@
 #include "game.hpp"
+#include "../common/bench.hpp"
+#include "../common/session.hpp"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
 
 Game::Game()
 {
+    highscore = LoadHighScore();
     InitGame();
 }
 
@@ -12,30 +16,44 @@ Game::~Game() {
     Alien::UnloadImages();
 }
 
-void Game::Draw() {
-    spaceship.Draw();
+void Game::Draw(float alpha) {
+    spaceship.Draw(alpha);
     for (auto& laser: spaceship.lasers) {
-        laser.Draw();
+        laser.Draw(alpha);
     }
     for (auto& obstacle : obstacles) {
         obstacle.Draw();
     }
     for (auto& alien : aliens) {
-        alien.Draw();
+        alien.Draw(alpha);
+    }
+    for (auto& laser : alienLasers) {
+        laser.Draw(alpha);
+    }
+    mysteryship.Draw(alpha);
+}
+
+void Game::KeepPositions() {
+    spaceship.KeepPosition();
+    for (auto& laser: spaceship.lasers) {
+        laser.KeepPosition();
+    }
+    for (auto& alien : aliens) {
+        alien.KeepPosition();
     }
     for (auto& laser : alienLasers) {
-        laser.Draw();
+        laser.KeepPosition();
     }
-    mysteryship.Draw();
+    mysteryship.KeepPosition();
 }
 
 void Game::Update() {
     if (run) {
-        double currentTime = GetTime();
+        double currentTime = Session().Time();
         if (currentTime - timeLastSpawn > mysteryShipSpawnInterval) {
             mysteryship.Spawn();
-            timeLastSpawn = GetTime();
-            mysteryShipSpawnInterval = GetRandomValue(10, 20); 
+            timeLastSpawn = Session().Time();
+            mysteryShipSpawnInterval = Session().Random(10, 20); 
         }
 
         for (auto& laser: spaceship.lasers) {
@@ -56,13 +74,13 @@ void Game::Update() {
             alienSpeedMul *= 1.2f;
             aliensDirection = 1;
             alienLasers.clear();
-            timeLastAlienFired = GetTime();
-            timeLastSpawn = GetTime();
-            aliens = CreateAliens();
+            timeLastAlienFired = Session().Time();
+            timeLastSpawn = Session().Time();
+            CreateAliens();
         }
 
     } else {
-        if(IsKeyDown(KEY_R)) {
+        if(Session().KeyDown(KEY_R)) {
             Reset();
             InitGame();
         }
@@ -72,48 +90,47 @@ void Game::Update() {
 
 void Game::HandleInput() {
     if (run) {
-        if (IsKeyDown(KEY_LEFT)) {
+        if (Session().KeyDown(KEY_LEFT)) {
             spaceship.MoveLeft();
-        } else if (IsKeyDown(KEY_RIGHT)) {
+        } else if (Session().KeyDown(KEY_RIGHT)) {
             spaceship.MoveRight();
-        } else if (IsKeyDown(KEY_SPACE)) {
+        } else if (Session().KeyDown(KEY_SPACE)) {
             spaceship.FireLaser();
         }
     }
 }
 
+// one pass each, keeping order; erasing one at a time moved the tail per laser
 void Game::DeleteInactivelasers() {
-    for (auto it = spaceship.lasers.begin(); it != spaceship.lasers.end();) {
-        if (!it -> active) {
-            it = spaceship.lasers.erase(it);
-        } else {
-            ++it;
-        }
-    }
-    for (auto it = alienLasers.begin(); it != alienLasers.end();) {
-        if (!it -> active) {
-            it = alienLasers.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    auto inactive = [](const Laser& laser) { return !laser.active; };
+    spaceship.lasers.erase(std::remove_if(spaceship.lasers.begin(), spaceship.lasers.end(), inactive),
+                           spaceship.lasers.end());
+    alienLasers.erase(std::remove_if(alienLasers.begin(), alienLasers.end(), inactive), alienLasers.end());
 }
 
-std::vector<Obstacle> Game::CreateObstacles()
+// Rebuilt in place, so a new game reuses the bunkers' block storage
+void Game::CreateObstacles()
 {
     int obstacleWidth = Obstacle::grid[0].size() * 4;
     float gap = (GetScreenWidth() - (4 * obstacleWidth)) / 5;
+    obstacles.reserve(4);
 
     for (int i=0; i<4; i++) {
         float offset_x = (i + 1) * gap + i * obstacleWidth;
-        obstacles.push_back(Obstacle({offset_x, (float)GetScreenHeight() - 200}));
+        Vector2 position = {offset_x, (float)GetScreenHeight() - 200};
+        if (i < (int)obstacles.size()) {
+            obstacles[i].Build(position);
+        } else {
+            obstacles.push_back(Obstacle(position));
+        }
     }
-    return obstacles;
 }
 
-std::vector<Alien> Game::CreateAliens()
+// Refills the fleet in place, so a new wave or game allocates nothing
+void Game::CreateAliens()
 {
-    std::vector<Alien> aliens;
+    aliens.clear();
+    aliens.reserve(5 * 13);
     for (int row=0; row<5; row++) {
         for (int col = 0; col < 13; col++) {
             int alienType;
@@ -130,7 +147,6 @@ std::vector<Alien> Game::CreateAliens()
             aliens.push_back(Alien(alienType, {x, y}));
         }
     }
-    return aliens;
 }
 
 void Game::MoveAliens() {
@@ -154,13 +170,13 @@ void Game::MoveDownAliens(int distance) {
 }
 
 void Game::AliensShootLaser() {
-    double currentTime = GetTime();
+    double currentTime = Session().Time();
     if (currentTime - timeLastAlienFired >= alienLaserInterval && !aliens.empty()) {
-        int randomIdx = GetRandomValue(0, aliens.size() - 1);
+        int randomIdx = Session().Random(0, aliens.size() - 1);
         Alien& alien = aliens[randomIdx];
         alienLasers.push_back(Laser({alien.position.x + alien.alienImages[alien.type-1].width/2,
                                 alien.position.y + alien.alienImages[alien.type-1].height}, 6));
-        timeLastAlienFired = GetTime();
+        timeLastAlienFired = Session().Time();
     }   
 }
 
@@ -241,15 +257,17 @@ void Game::GameOver() {
 
 void Game::InitGame() {
     alienSpeedMul = 1.0;
-    obstacles = CreateObstacles();
-    aliens = CreateAliens();
+    // reserved once, so firing never grows them mid-game
+    spaceship.lasers.reserve(laserCapacity);
+    alienLasers.reserve(laserCapacity);
+    CreateObstacles();
+    CreateAliens();
     aliensDirection = 1;
     timeLastAlienFired = 0;
     timeLastSpawn = 0.0;
-    mysteryShipSpawnInterval = GetRandomValue(10, 20);
+    mysteryShipSpawnInterval = Session().Random(10, 20);
     lives = 3;
     score = 0;
-    highscore = LoadHighScore();
     run = true;
 }
 
@@ -286,5 +304,42 @@ void Game::Reset() {
     spaceship.Reset();
     aliens.clear();
     alienLasers.clear();
-    obstacles.clear();
-}
\ No newline at end of file
+}
+
+// --- Benchmarks ---
+// One frame's collision pass with `size` lasers from each side in flight.
+// They sit in the gap between the fleet and the bunkers, so nothing is hit
+// and every run scans the same scene.
+void AddInvadersBenchmarks(BenchSuite& suite) {
+    static Game* scene = nullptr;
+    suite.Add({"invaders/collisions", "lasers", {1, 16, 256},
+        [](int size, uint64_t seed) {
+            Session().SeedRandom(seed);
+            scene = new Game();
+            scene->mysteryship.Spawn();
+            float top = 120 + 5 * 60;
+            float bottom = GetScreenHeight() - 200 - 15;
+            for (int i = 0; i < size; i++) {
+                float x = Session().Random(25, GetScreenWidth() - 25);
+                float y = Session().Random(top, bottom);
+                scene->spaceship.lasers.push_back(Laser({x, y}, -6));
+                scene->alienLasers.push_back(Laser({x, y}, 6));
+            }
+        },
+        [] {
+            scene->CheckForCollisions();
+            BenchSink(scene->aliens.size() + scene->obstacles[0].blocks.size());
+        },
+        [] { delete scene; scene = nullptr; }});
+
+    // Building `size` bunkers block by block; every new game builds four
+    static int bunkers = 0;
+    suite.Add({"invaders/obstacle", "obstacles", {1, 4, 64},
+        [](int size, uint64_t) { bunkers = size; },
+        [] {
+            std::vector<Obstacle> built;
+            for (int i = 0; i < bunkers; i++) built.push_back(Obstacle({i * 4.0f, 600}));
+            BenchSink(built.back().blocks.size());
+        },
+        nullptr});
+}
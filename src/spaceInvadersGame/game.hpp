@@ -4,13 +4,15 @@
 #include "alien.hpp"
 #include "mysteryship.hpp"
 
+class BenchSuite;
+
 class Game {
     private:
         Spaceship spaceship;
         void DeleteInactivelasers();
-        std::vector<Obstacle> CreateObstacles();
+        void CreateObstacles();
         std::vector<Obstacle> obstacles;
-        std::vector<Alien> CreateAliens();
+        void CreateAliens();
         std::vector<Alien> aliens;
         void MoveAliens();
         int aliensDirection;
@@ -18,6 +20,9 @@ class Game {
         std::vector<Laser> alienLasers;
         void AliensShootLaser();
         constexpr static float alienLaserInterval = 0.35;
+        // more than either side can have in flight: the ship fires every
+        // 0.15 s and a laser crosses the screen in about 2 s
+        constexpr static int laserCapacity = 32;
         float timeLastAlienFired;
         MysteryShip mysteryship;
         float mysteryShipSpawnInterval;
@@ -28,10 +33,15 @@ class Game {
         void CheckHighScore();
         void SaveHighscoreToFile(int highscore);
         int LoadHighScore();
+        // sets up scenes straight on the private state
+        friend void AddInvadersBenchmarks(BenchSuite& suite);
     public:
         Game();
         ~Game();
-        void Draw();
+        // alpha: how far the frame is from the last step to the next
+        void Draw(float alpha);
+        // Notes where everything is, for Draw(); call before each step
+        void KeepPositions();
         void Update();
         void HandleInput();
         void Reset();
@@ -1,5 +1,7 @@
 #include "invaders.hpp"
 #include "game.hpp"
+#include "../common/assetpack.hpp"
+#include "../common/session.hpp"
 #include <raylib.h>
 #include <string>
 #include <cmath>
@@ -14,16 +16,21 @@ namespace {
     float countdownTimer = 3.0f;
     const int offset = 80;
 
-    std::string FormatWithLeadingZeros(int number, int width) {
-        std::string txt = std::to_string(number);
-        int pad = width - (int)txt.length();
-        return std::string(pad > 0 ? pad : 0, '0') + txt;
+    // Everything moves a fixed distance per step, tuned at 60 steps a
+    // second; frames draw between the last two steps
+    const float STEP = 1.0f / 60.0f;
+    const float MAX_FRAME_TIME = 0.25f;
+    float accumulator = 0;          // frame time not yet stepped
+
+    // into raylib's TextFormat buffer, so drawing the HUD never allocates
+    const char* FormatWithLeadingZeros(int number, int width) {
+        return TextFormat("%0*d", width, number);
     }
 }
 
 bool InitInvaders() {
     // assume window already initialized by main launcher
-    shipTex = LoadTexture("data/spaceInvaders/Graphics/spaceship.png");
+    shipTex = Assets().LoadTexture("data/spaceInvaders/Graphics/spaceship.png");
     game = new Game();
     game->InitGame();
     state = IState::Start;
@@ -33,7 +40,7 @@ bool InitInvaders() {
 
 void UpdateInvaders() {
     // ——— GLOBAL INPUT ———
-    if (IsKeyPressed(KEY_BACKSPACE)) {
+    if (Session().KeyPressed(KEY_BACKSPACE)) {
         // full reset back to Start
         state = IState::Start;
         game->Reset();
@@ -43,36 +50,41 @@ void UpdateInvaders() {
 
     // ——— STATE‑SPECIFIC INPUT ———
     if (state == IState::Start) {
-        if (IsKeyPressed(KEY_ENTER)) {
+        if (Session().KeyPressed(KEY_ENTER)) {
             state = IState::Countdown;
             countdownTimer = 3.0f;
         }
     }
     else if (state == IState::Playing) {
         // allow 'R' to restart once it's Game Over
-        if (!game->run && IsKeyPressed(KEY_R)) {
+        if (!game->run && Session().KeyPressed(KEY_R)) {
             game->Reset();
             game->InitGame();
             state = IState::Start;
             return;
         }
-        game->HandleInput();
     }
 
     // ——— UPDATE ———
     if (state == IState::Countdown) {
-        countdownTimer -= GetFrameTime();
+        countdownTimer -= Session().FrameTime();
         if (countdownTimer <= 0.0f) {
             state = IState::Playing;
+            accumulator = 0;
         }
     }
     else if (state == IState::Playing) {
-        game->Update();
+        accumulator += fminf(Session().FrameTime(), MAX_FRAME_TIME);
+        while (accumulator >= STEP) {
+            accumulator -= STEP;
+            game->KeepPositions();
+            game->HandleInput();
+            game->Update();
+        }
     }
 }
 
 void DrawInvaders() {
-    BeginDrawing();
     ClearBackground(BLACK);
 
     int winW = GetScreenWidth();
@@ -118,16 +130,14 @@ void DrawInvaders() {
 
             // Scores
             DrawText("SCORE",      60,  20, 36, YELLOW);
-            DrawText(FormatWithLeadingZeros(game->score,     5).c_str(), 60, 50, 36, YELLOW);
+            DrawText(FormatWithLeadingZeros(game->score,     5), 60, 50, 36, YELLOW);
             DrawText("HIGH SCORE", 920, 20, 36, YELLOW);
-            DrawText(FormatWithLeadingZeros(game->highscore, 5).c_str(), 1050, 50, 36, YELLOW);
+            DrawText(FormatWithLeadingZeros(game->highscore, 5), 1050, 50, 36, YELLOW);
 
             // Game world
-            game->Draw();
+            game->Draw(accumulator / STEP);
             break;
     }
-
-    EndDrawing();
 }
 
 void UnloadInvaders() {
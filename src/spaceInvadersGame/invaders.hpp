@@ -1,7 +1,11 @@
 #pragma once
 #include "raylib.h"
 
+class BenchSuite;
+
 bool InitInvaders();
 void UpdateInvaders();
 void DrawInvaders();
-void UnloadInvaders();
\ No newline at end of file
+void UnloadInvaders();
+// Adds collision checks and obstacle building to ArcadeBench.
+void AddInvadersBenchmarks(BenchSuite& suite);
\ No newline at end of file
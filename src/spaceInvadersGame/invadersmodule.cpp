@@ -0,0 +1,7 @@
+#include "invaders.hpp"
+#include "../gamemodule.hpp"
+
+extern "C" const GameModule* ArcadeGetModule() {
+    static const GameModule module = {"Space Invaders", InitInvaders, UpdateInvaders, DrawInvaders, UnloadInvaders, nullptr, nullptr, AddInvadersBenchmarks};
+    return &module;
+}
@@ -1,7 +1,9 @@
 #include "laser.hpp"
+#include <raymath.h>
 
 Laser::Laser(Vector2 position, int speed) {
     this -> position = position;
+    this -> previousPosition = position;
     this -> speed = speed;
     active = true;
 }
@@ -10,13 +12,18 @@ Laser::~Laser() {
 
 }
 
-void Laser::Draw() {
+void Laser::Draw(float alpha) {
     if (active) {
-        DrawRectangle(position.x, position.y, 4, 15, YELLOW);
+        Vector2 at = Vector2Lerp(previousPosition, position, alpha);
+        DrawRectangle(at.x, at.y, 4, 15, YELLOW);
     }
     
 }
 
+void Laser::KeepPosition() {
+    previousPosition = position;
+}
+
 void Laser::Update() {
     position.y += speed;
     if (active) {
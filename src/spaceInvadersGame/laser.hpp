@@ -4,11 +4,13 @@
 class Laser {
     private:
         Vector2 position;
+        Vector2 previousPosition;   // at the start of the step
         int speed;
     public:
         Laser(Vector2 position, int speed);
         ~Laser();
-        void Draw();
+        void Draw(float alpha);
+        void KeepPosition();
         void Update();
         bool active;
         Rectangle getRect();
@@ -1,7 +1,10 @@
 #include "mysteryship.hpp"
+#include "../common/assetpack.hpp"
+#include "../common/session.hpp"
+#include <raymath.h>
 
 MysteryShip::MysteryShip() {
-    image = LoadTexture("data/spaceInvaders/Graphics/mystery.png");
+    image = Assets().LoadTexture("data/spaceInvaders/Graphics/mystery.png");
     alive = false;
 }
 
@@ -9,12 +12,16 @@ MysteryShip::~MysteryShip() {
     UnloadTexture(image);
 }
 
-void MysteryShip::Draw() {
+void MysteryShip::Draw(float alpha) {
     if (alive) {
-        DrawTextureV(image, position, WHITE);
+        DrawTextureV(image, Vector2Lerp(previousPosition, position, alpha), WHITE);
     }
 }
 
+void MysteryShip::KeepPosition() {
+    previousPosition = position;
+}
+
 void MysteryShip::Update() {
     if (alive) {
         position.x += speed;
@@ -26,7 +33,7 @@ void MysteryShip::Update() {
 
 void MysteryShip::Spawn() {
     position.y = 90;
-    int side = GetRandomValue(0, 1);
+    int side = Session().Random(0, 1);
     if (side == 0) {
         position.x = 25;
         speed = 3;
@@ -34,6 +41,7 @@ void MysteryShip::Spawn() {
         position.x = GetScreenWidth() - image.width - 25;
         speed = -3;
     }
+    previousPosition = position;
     alive = true;
 }
 
@@ -4,13 +4,15 @@
 class MysteryShip {
     private:    
         Vector2 position;
+        Vector2 previousPosition;   // at the start of the step
         Texture2D image;
         int speed;
 
     public:
         MysteryShip();
         ~MysteryShip();
-        void Draw();
+        void Draw(float alpha);
+        void KeepPosition();
         void Update();
         void Spawn();
         bool alive;
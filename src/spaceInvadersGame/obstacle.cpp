@@ -19,7 +19,13 @@ std::vector<std::vector<int>> Obstacle::grid = {
 };
 
 Obstacle::Obstacle(Vector2 position) {
+    Build(position);
+}
+
+void Obstacle::Build(Vector2 position) {
     this -> position = position;
+    blocks.clear();
+    blocks.reserve(grid.size() * grid[0].size());
     for (unsigned int row=0; row<grid.size(); ++row) {
         for (unsigned int col=0; col<grid[0].size(); ++col) {
             if(grid[row][col] == 1) {
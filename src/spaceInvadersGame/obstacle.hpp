@@ -7,6 +7,8 @@ class Obstacle {
 
     public:
         Obstacle(Vector2 position);
+        // Puts every block back at `position`, reusing the block storage
+        void Build(Vector2 position);
         void Draw();
         Vector2 position;
         std::vector<Block> blocks;
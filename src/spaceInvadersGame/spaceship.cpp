@@ -1,10 +1,14 @@
 #include "spaceship.hpp"
+#include "../common/assetpack.hpp"
+#include "../common/session.hpp"
+#include <raymath.h>
 
 Spaceship::Spaceship()
 {
-    image = LoadTexture("data/spaceInvaders/Graphics/spaceship.png");
+    image = Assets().LoadTexture("data/spaceInvaders/Graphics/spaceship.png");
     position.x = (GetScreenWidth() - image.width) / 2;
     position.y = GetScreenHeight() - image.height - 100;
+    previousPosition = position;
     lastFireTime = 0.0;
 }
 
@@ -12,8 +16,12 @@ Spaceship::~Spaceship() {
     UnloadTexture(image);
 }
 
-void Spaceship::Draw() {
-    DrawTextureV(image, position, WHITE);
+void Spaceship::Draw(float alpha) {
+    DrawTextureV(image, Vector2Lerp(previousPosition, position, alpha), WHITE);
+}
+
+void Spaceship::KeepPosition() {
+    previousPosition = position;
 }
 
 void Spaceship::MoveLeft() {
@@ -31,9 +39,9 @@ void Spaceship::MoveRight() {
 }
 
 void Spaceship::FireLaser() {
-    if (GetTime() - lastFireTime >= 0.15) {
+    if (Session().Time() - lastFireTime >= 0.15) {
         lasers.push_back(Laser({position.x + image.width/2-2, position.y}, -6));
-        lastFireTime = GetTime();
+        lastFireTime = Session().Time();
     }
 }
 
@@ -45,5 +53,6 @@ Rectangle Spaceship::getRect()
 void Spaceship::Reset() {
     position.x = (GetScreenWidth() - image.width) / 2.0f;
     position.y = GetScreenHeight() - image.height - 100;
+    previousPosition = position;
     lasers.clear();
 }
\ No newline at end of file
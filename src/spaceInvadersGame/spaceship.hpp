@@ -7,12 +7,14 @@ class Spaceship {
     private:
         Texture2D image;
         Vector2 position;
+        Vector2 previousPosition;   // at the start of the step
         double lastFireTime;
 
     public:
         Spaceship();
         ~Spaceship();
-        void Draw();
+        void Draw(float alpha);
+        void KeepPosition();
         void MoveLeft();
         void MoveRight();
         void FireLaser();